@@ -21,8 +21,9 @@ int main() {
     normalized.push_back(0);
     SAVE_SIGNAL_TF("../data/shorted_to_send.txt", normalized, static_cast<unsigned short>(x + 2048));
     
-    // 重采样到 808 周期对应的参考信号
-    auto resampled = resample<64, 8192, 512>(send_signal<8192>(x0), 1e6f, 1e8f / 808);
+    // 重采样到 808 周期对应的参考信号，524288 点反变换在线程池上并行
+    thread_pool_t pool;
+    auto          resampled = resample<64, 8192, 512>(send_signal<8192>(x0, transducer_response_path()), 1e6f, 1e8f / 808, pool);
     normalize(resampled, 1024.0f);
     SAVE_SIGNAL_FORMAT("../data/shorted_for_reference.txt", resampled, static_cast<short>(x) << ',');
     return 0;
@@ -41,8 +42,10 @@ void encode() {
     std::copy(w3::memory[2], w3::memory[3], code.begin());
     auto x1 = encode(code, map);
     
-    auto y0 = send_signal<1024>(x0);
-    auto y1 = send_signal<1024>(x1);
+    const auto response = transducer_response_path();
+    
+    auto y0 = send_signal<1024>(x0, response);
+    auto y1 = send_signal<1024>(x1, response);
     
     std::vector<float> yy(4096, 0);
     
@@ -55,11 +58,9 @@ void encode() {
         normalize<float>(yy, 4096);
     }
     
-    auto Y0 = std::vector(yy);
-    auto Y1 = std::vector(yy);
-    
-    xcorr<4096>(xcorr_init<4096>(y0), Y0);
-    xcorr<4096>(xcorr_init<4096>(y1), Y1);
+    auto Y  = xcorr<4096>(xcorr_init_split<4096>(vec<vec<float>>{y0, y1}), yy);
+    auto Y0 = std::move(Y[0]),
+         Y1 = std::move(Y[1]);
     
     SAVE_SIGNAL("../data/yy.txt", yy);
     SAVE_SIGNAL("../data/y0.txt", y0);
@@ -0,0 +1,189 @@
+#ifndef SIMULATION_ANALYTIC_SIGNAL_H
+#define SIMULATION_ANALYTIC_SIGNAL_H
+
+#include <vector>
+#include <cmath>
+
+#include "../signal/complex_t.hpp"
+#include "overlap_save.h"
+#include "resampler.h"
+
+/**
+ * 流式解析信号发生器（FIR 希尔伯特变换）
+ * @remarks 虚部由 2D+1 点凯泽窗希尔伯特滤波器经重叠保留法得到，实部为延迟 D 点的原信号，
+ *          与 `hilbert` 相同，虚部超前实部 90°。输出相对输入延迟 D 点，可逐块接在相关器之后。
+ *          输出为复数，不能直接作为 `pipeline_t` 的处理级；流水线中使用 `envelope_detector_t`。
+ */
+class analytic_signal_t {
+    size_t             _delay;
+    overlap_save_t     _filter;
+    std::vector<float> _real, _imaginary; // 实部延迟线，滤波器输出
+    size_t             _read;             // 实部延迟线中已输出的点数
+    
+    static std::vector<float> design(size_t delay, double beta) {
+        std::vector<float> h(2 * delay + 1, 0);
+        
+        const auto norm = resampler::bessel_i0(beta);
+        for (size_t i = 1; i <= delay; i += 2) {
+            const auto r = static_cast<double>(i) / (delay + 1),
+                       w = resampler::bessel_i0(beta * std::sqrt(1 - r * r)) / norm;
+            const auto k = static_cast<float>(2 / (M_PI * i) * w);
+            h[delay - i] = k;
+            h[delay + i] = -k;
+        }
+        return h;
+    }
+    
+    /// 实部送入延迟线；已输出部分超过一半时才整体前移，每点摊销 O(1)
+    void push(float const *input, size_t length) {
+        if (_read && 2 * _read >= _real.size()) {
+            _real.erase(_real.begin(), _real.begin() + _read);
+            _read = 0;
+        }
+        _real.insert(_real.end(), input, input + length);
+    }
+    
+    /// 把已得到的虚部与对应的实部配对输出
+    template<class sink_t>
+    void emit(sink_t const &sink) {
+        const auto n = std::min(_imaginary.size(), _real.size() - _read);
+        for (size_t i = 0; i < n; ++i) sink(_real[_read + i], _imaginary[i]);
+        _read += n;
+        _imaginary.clear();
+    }
+
+public:
+    /**
+     * 构造解析信号发生器
+     * @param delay 半长 D，决定滤波器长度和输出延迟
+     * @param beta 凯泽窗参数
+     */
+    explicit analytic_signal_t(size_t delay = 64, double beta = 8)
+        : _delay(delay), _filter(design(delay, beta)), _read(0) {
+        reset();
+    }
+    
+    /// 清除历史输入，回到初始状态
+    void reset() {
+        _filter.reset();
+        _real.assign(_delay, 0);
+        _imaginary.clear();
+        _read = 0;
+    }
+    
+    /// 输出相对输入的延迟（点数）
+    [[nodiscard]]
+    size_t latency() const {
+        return _delay;
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param output 产生的解析信号追加到此处
+     */
+    void process(float const *input, size_t length, std::vector<complex_t> &output) {
+        push(input, length);
+        _filter.process(input, length, _imaginary);
+        emit([&](float re, float im) { output.push_back({re, im}); });
+    }
+    
+    /// 送入一段输入，返回这次产生的解析信号
+    std::vector<complex_t> process(std::vector<float> const &input) {
+        std::vector<complex_t> output;
+        process(input.data(), input.size(), output);
+        return output;
+    }
+    
+    /**
+     * 送入一段输入，输出包络和瞬时相位
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param envelope 包络追加到此处
+     * @param phase 瞬时相位（弧度，(-π, π]）追加到此处
+     */
+    void process(float const *input, size_t length, std::vector<float> &envelope, std::vector<float> &phase) {
+        push(input, length);
+        _filter.process(input, length, _imaginary);
+        emit([&](float re, float im) {
+            envelope.push_back(std::hypot(re, im));
+            phase.push_back(std::atan2(im, re));
+        });
+    }
+    
+    /**
+     * 排空滤波器和延迟线，输出剩余部分，然后回到初始状态
+     * @remarks 与各次 `process` 的输出合计，共输出 输入点数 + D 个点。
+     * @param output 输出追加到此处
+     */
+    void flush(std::vector<complex_t> &output) {
+        _filter.flush(_imaginary);
+        emit([&](float re, float im) { output.push_back({re, im}); });
+        reset();
+    }
+    
+    /// 排空滤波器和延迟线，输出剩余的包络和瞬时相位，然后回到初始状态
+    void flush(std::vector<float> &envelope, std::vector<float> &phase) {
+        _filter.flush(_imaginary);
+        emit([&](float re, float im) {
+            envelope.push_back(std::hypot(re, im));
+            phase.push_back(std::atan2(im, re));
+        });
+        reset();
+    }
+};
+
+/**
+ * 流式包络检波器
+ * @remarks 以 `analytic_signal_t` 求解析信号并只输出其模，输入输出都是实数，
+ *          可作为 `pipeline_t` 的处理级。输出相对输入延迟 D 点。
+ */
+class envelope_detector_t {
+    analytic_signal_t  _analytic;
+    std::vector<float> _phase;
+
+public:
+    /**
+     * 构造包络检波器
+     * @param delay 希尔伯特滤波器半长 D
+     * @param beta 凯泽窗参数
+     */
+    explicit envelope_detector_t(size_t delay = 64, double beta = 8) : _analytic(delay, beta) {}
+    
+    void reset() {
+        _analytic.reset();
+    }
+    
+    /// 输出相对输入的延迟（点数）
+    [[nodiscard]]
+    size_t latency() const {
+        return _analytic.latency();
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param output 包络追加到此处
+     */
+    void process(float const *input, size_t length, std::vector<float> &output) {
+        _analytic.process(input, length, output, _phase);
+        _phase.clear();
+    }
+    
+    /// 送入一段输入，返回这次产生的包络
+    std::vector<float> process(std::vector<float> const &input) {
+        std::vector<float> output;
+        process(input.data(), input.size(), output);
+        return output;
+    }
+    
+    /// 排空内部状态，输出剩余的包络
+    void flush(std::vector<float> &output) {
+        _analytic.flush(output, _phase);
+        _phase.clear();
+    }
+};
+
+#endif // SIMULATION_ANALYTIC_SIGNAL_H
@@ -0,0 +1,117 @@
+#ifndef SIMULATION_ARENA_H
+#define SIMULATION_ARENA_H
+
+#include <new>
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * 临时内存区
+ * @remarks 按顺序切分预先申请的大块内存，用 `mark`/`rewind`（或 `arena_scope_t`）整体归还。
+ *          内存块只增不减，处理循环经过第一帧达到峰值用量后，之后的每帧都不再向堆申请内存。
+ *          每个线程用自己的一份（`thread_arena()`），无需加锁。
+ */
+class scratch_arena_t {
+    constexpr static size_t align = 64;
+    
+    struct block_t {
+        std::byte *data;
+        size_t    size;
+    };
+    
+    std::vector<block_t> _blocks;
+    size_t               _block, _offset;
+
+public:
+    struct mark_t {
+        size_t block, offset;
+    };
+    
+    scratch_arena_t() : _block(0), _offset(0) {}
+    
+    scratch_arena_t(scratch_arena_t const &) = delete;
+    
+    scratch_arena_t &operator=(scratch_arena_t const &) = delete;
+    
+    ~scratch_arena_t() {
+        for (auto block : _blocks) ::operator delete(block.data, std::align_val_t{align});
+    }
+    
+    /// 当前位置
+    [[nodiscard]]
+    mark_t mark() const {
+        return {_block, _offset};
+    }
+    
+    /// 归还 `mark` 之后取得的所有内存
+    void rewind(mark_t mark) {
+        _block  = mark.block;
+        _offset = mark.offset;
+    }
+    
+    /// 已申请的总字节数
+    [[nodiscard]]
+    size_t capacity() const {
+        size_t sum = 0;
+        for (auto block : _blocks) sum += block.size;
+        return sum;
+    }
+    
+    /**
+     * 取得 n 个对象的未初始化存储，按 64 字节对齐
+     * @tparam t 对象类型，须可平凡复制和析构
+     */
+    template<class t>
+    std::span<t> allocate(size_t n) {
+        static_assert(std::is_trivially_copyable_v<t> && std::is_trivially_destructible_v<t>);
+        
+        const auto bytes = std::max<size_t>(n * sizeof(t), 1);
+        auto       offset = (_offset + align - 1) / align * align;
+        
+        while (_block >= _blocks.size() || offset + bytes > _blocks[_block].size) {
+            if (_block < _blocks.size()) ++_block;
+            offset = 0;
+            if (_block == _blocks.size()) {
+                const auto size = std::max({bytes, size_t{1} << 16u,
+                                            _blocks.empty() ? 0 : 2 * _blocks.back().size});
+                _blocks.push_back({static_cast<std::byte *>(::operator new(size, std::align_val_t{align})), size});
+            }
+        }
+        
+        _offset = offset + bytes;
+        return {reinterpret_cast<t *>(_blocks[_block].data + offset), n};
+    }
+};
+
+/// 当前线程的临时内存区
+inline scratch_arena_t &thread_arena() {
+    thread_local scratch_arena_t arena;
+    return arena;
+}
+
+/// 作用域结束时归还期间取得的临时内存
+class arena_scope_t {
+    scratch_arena_t         &_arena;
+    scratch_arena_t::mark_t _mark;
+
+public:
+    explicit arena_scope_t(scratch_arena_t &arena = thread_arena()) : _arena(arena), _mark(arena.mark()) {}
+    
+    arena_scope_t(arena_scope_t const &) = delete;
+    
+    arena_scope_t &operator=(arena_scope_t const &) = delete;
+    
+    ~arena_scope_t() {
+        _arena.rewind(_mark);
+    }
+    
+    template<class t>
+    std::span<t> allocate(size_t n) {
+        return _arena.template allocate<t>(n);
+    }
+};
+
+#endif // SIMULATION_ARENA_H
@@ -6,7 +6,18 @@
 #define FFT_FFT_H
 
 #include <utility>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
 #include "../signal/complex_t.hpp"
+#include "../signal/split_complex_t.hpp"
+#include "static_check.h"
+#include "fft_kernel.h"
 
 /// 计算所需的 FFT 点数
 template<class num_t, num_t n0, num_t n1>
@@ -20,7 +31,7 @@ complex_t omega(decltype(_n) k) {
     constexpr static auto t0 = 2 * M_PI / _n;
     
     float theta = t0 * k;
-    return {std::cosf(theta), std::sinf(theta)};
+    return {std::cos(theta), std::sin(theta)};
 }
 
 /// 用于反变换的 ω<n,k>
@@ -29,45 +40,401 @@ complex_t omega_inverse(decltype(_n) k) {
     constexpr static auto t0 = 2 * M_PI / _n;
     
     float theta = t0 * k;
-    return {std::cosf(theta), -std::sinf(theta)};
+    return {std::cos(theta), -std::sin(theta)};
 }
 
-/// 基 2 快速傅里叶正变换
-template<auto _n>
-void fft(
-    complex_t memory[_n],
-    complex_t _omega(decltype(_n)) = omega<_n>
-) {
-    // 错序
-    for (size_t i = 0, j = 0; i < _n; ++i) {
-        if (i > j) std::swap(memory[i], memory[j]);
-        for (size_t l = _n >> 1u; (j ^= l) < l; l >>= 1u);
-    }
-    // 变换
-    for (size_t m = 1; m < _n; m <<= 1u) {
-        auto        a = memory, b = a + m;
-        const auto  s = _n / m / 2;
-        for (size_t i = 0; i < s; ++i) {
-            for (size_t j = 0; j < m; ++j, ++a, ++b)
-                if (b->is_zero())
-                    *b = *a;
-                else {
-                    const auto t = *b * _omega(s * j);
-                    *b = *a - t;
-                    *a += t;
-                }
-            a = b;
-            b += m;
+/**
+ * FFT 变换计划
+ * @remarks 旋转因子表和错序置换表只在构造时计算一次，同一长度的所有变换共享，
+ *          蝶形运算内不再调用三角函数。按长度选择算法：
+ *          - 2 的整数次幂：基 4 内核，由 `fft_kernel` 按处理器指令集选择实现；
+ *          - 可分解为 2、3、5、7 之积：混合基内核；
+ *          - 其他（含较大素因子）：Bluestein 算法，转化为 2 的整数次幂长度的循环卷积。
+ *          长度为 0 时抛出 `std::invalid_argument`。
+ */
+class fft_plan_t {
+    enum class algorithm_t { radix4, mixed_radix, bluestein };
+    
+    size_t                                     _length;
+    algorithm_t                                _algorithm;
+    std::vector<complex_t>                     _omega;    // ω<n,k>
+    // 基 4
+    std::vector<complex_t>                     _twiddles; // 基 4 各级旋转因子
+    std::vector<float>                         _twiddles_re, _twiddles_im;
+    std::vector<std::pair<uint32_t, uint32_t>> _swaps;
+    // 混合基
+    std::vector<size_t>                        _factors;
+    // Bluestein
+    std::vector<complex_t>                     _chirp;    // exp(jπk²/n)
+    std::vector<complex_t>                     _kernel;   // 共轭 chirp 的变换
+    std::unique_ptr<fft_plan_t>                _sub;
+    
+    void transform(complex_t *memory, bool inverse) const {
+        switch (_algorithm) {
+            case algorithm_t::radix4:
+                // 错序
+                for (auto[i, j] : _swaps) std::swap(memory[i], memory[j]);
+                // 变换
+                fft_kernel::run(memory, _length, _twiddles.data(), inverse);
+                break;
+            case algorithm_t::mixed_radix:
+            case algorithm_t::bluestein:
+                // 反变换 = 共轭 -> 正变换 -> 共轭
+                if (inverse)
+                    for (auto p = memory; p < memory + _length; ++p) p->im = -p->im;
+                if (_algorithm == algorithm_t::mixed_radix) {
+                    thread_local std::vector<complex_t> buffer;
+                    buffer.assign(memory, memory + _length);
+                    fft_kernel::mixed_radix(memory, buffer.data(), 1, _factors.data(), _length, _omega.data(), _length);
+                } else
+                    bluestein(memory);
+                if (inverse)
+                    for (auto p = memory; p < memory + _length; ++p) p->im = -p->im;
+                break;
+        }
+    }
+    
+    void transform(float *re, float *im, bool inverse) const {
+        if (_algorithm == algorithm_t::radix4) {
+            // 错序
+            for (auto[i, j] : _swaps) {
+                std::swap(re[i], re[j]);
+                std::swap(im[i], im[j]);
+            }
+            // 变换
+            fft_kernel::run(re, im, _length, _twiddles_re.data(), _twiddles_im.data(), inverse);
+        } else {
+            thread_local std::vector<complex_t> buffer;
+            buffer.resize(_length);
+            for (size_t i = 0; i < _length; ++i) buffer[i] = {re[i], im[i]};
+            transform(buffer.data(), inverse);
+            for (size_t i = 0; i < _length; ++i) re[i] = buffer[i].re, im[i] = buffer[i].im;
+        }
+    }
+    
+    void bluestein(complex_t *memory) const {
+        const auto m = _kernel.size();
+        
+        thread_local std::vector<complex_t> buffer;
+        buffer.assign(m, complex_t::zero);
+        for (size_t i = 0; i < _length; ++i) buffer[i] = memory[i] * _chirp[i];
+        _sub->forward(buffer.data());
+        for (size_t i = 0; i < m; ++i) buffer[i] *= _kernel[i];
+        _sub->inverse(buffer.data());
+        for (size_t i = 0; i < _length; ++i) memory[i] = buffer[i] * _chirp[i];
+    }
+
+public:
+    /// 构造 n 点变换计划
+    explicit fft_plan_t(size_t n) : _length(n) {
+        if (n == 0) throw std::invalid_argument("fft size must be positive");
+        if (check_power_2(n)) {
+            _algorithm = algorithm_t::radix4;
+            _omega.resize(n / 2);
+            _twiddles = fft_kernel::build_twiddles(n);
+            for (auto w : _twiddles) {
+                _twiddles_re.push_back(w.re);
+                _twiddles_im.push_back(w.im);
+            }
+            for (size_t i = 0, j = 0; i < n; ++i) {
+                if (i > j) _swaps.emplace_back(i, j);
+                for (size_t l = n >> 1u; (j ^= l) < l; l >>= 1u);
+            }
+        } else if (!(_factors = fft_kernel::factorize(n)).empty()) {
+            _algorithm = algorithm_t::mixed_radix;
+            _omega.resize(n);
+        } else {
+            _algorithm = algorithm_t::bluestein;
+            _omega.resize(n);
+            
+            size_t m = 1;
+            while (m < 2 * n - 1) m <<= 1u;
+            _sub = std::make_unique<fft_plan_t>(m);
+            
+            // k² 对 2n 取模，避免大 k 时相位精度损失
+            _chirp.resize(n);
+            for (size_t k = 0; k < n; ++k) {
+                auto theta = M_PI * static_cast<double>(k * k % (2 * n)) / n;
+                _chirp[k] = {static_cast<float>(std::cos(theta)),
+                             static_cast<float>(std::sin(theta))};
+            }
+            _kernel.assign(m, complex_t::zero);
+            _kernel[0]    = _chirp[0].conjugate();
+            for (size_t k = 1; k < n; ++k)
+                _kernel[k] = _kernel[m - k] = _chirp[k].conjugate();
+            _sub->forward(_kernel.data());
+        }
+        
+        for (size_t k = 0; k < _omega.size(); ++k) {
+            auto theta = 2 * M_PI * k / n;
+            _omega[k] = {static_cast<float>(std::cos(theta)),
+                         static_cast<float>(std::sin(theta))};
+        }
+    }
+    
+    fft_plan_t(fft_plan_t const &) = delete;
+    
+    fft_plan_t &operator=(fft_plan_t const &) = delete;
+    
+    /// 变换长度
+    [[nodiscard]]
+    size_t size() const {
+        return _length;
+    }
+    
+    /// 查表得到 ω<n,k>
+    [[nodiscard]]
+    complex_t omega(size_t k) const {
+        k %= _length;
+        if (_omega.size() == _length) return _omega[k];
+        if (_omega.empty()) return {1, 0};
+        return k < _omega.size() ? _omega[k] : -_omega[k - _omega.size()];
+    }
+    
+    /// 原地正变换
+    void forward(complex_t *memory) const {
+        transform(memory, false);
+    }
+    
+    /// 原地反变换（含 1/n 归一化）
+    void inverse(complex_t *memory) const {
+        const auto k = 1.0f / _length;
+        
+        transform(memory, true);
+        for (auto p = memory; p < memory + _length; ++p)
+            *p *= k;
+    }
+    
+    /// 原地正变换，分离存储
+    void forward(float *re, float *im) const {
+        transform(re, im, false);
+    }
+    
+    /// 原地反变换（含 1/n 归一化），分离存储
+    void inverse(float *re, float *im) const {
+        const auto k = 1.0f / _length;
+        
+        transform(re, im, true);
+        for (size_t i = 0; i < _length; ++i) {
+            re[i] *= k;
+            im[i] *= k;
+        }
+    }
+};
+
+/**
+ * 实信号 FFT 变换计划
+ * @remarks 利用实信号频谱的共轭对称性，把 n 点实变换折算为 n/2 点复变换加一次分离/合并，
+ *          只保存 [0, n/2] 共 n/2+1 个频点。
+ *          时域数据以复数形式成对存放：memory[i] = {x[2i], x[2i+1]}。
+ *          长度必须是正偶数，否则抛出 `std::invalid_argument`；以长度为参数的 `rfft`、`convolve`、`xcorr` 等
+ *          都经由此计划，同样检查。
+ */
+class rfft_plan_t {
+    size_t                 _half;
+    fft_plan_t             _plan;
+    std::vector<complex_t> _twiddles; // ω<n,k>，0 <= k <= n/4
+    
+    static size_t half_of(size_t n) {
+        if (n == 0 || n % 2) throw std::invalid_argument("real fft size must be positive and even");
+        return n / 2;
+    }
+
+public:
+    /// 构造 n 点实变换计划
+    explicit rfft_plan_t(size_t n) : _half(half_of(n)), _plan(_half), _twiddles(_half / 2 + 1) {
+        for (size_t k = 0; k < _twiddles.size(); ++k) {
+            auto theta = 2 * M_PI * k / n;
+            _twiddles[k] = {static_cast<float>(std::cos(theta)),
+                            static_cast<float>(std::sin(theta))};
+        }
+    }
+    
+    /// 实信号长度
+    [[nodiscard]]
+    size_t size() const {
+        return 2 * _half;
+    }
+    
+    /// 原地正变换：成对存放的实信号 -> n/2+1 个频点
+    void forward(complex_t *memory) const {
+        _plan.forward(memory);
+        
+        // 分离奇偶两路频谱并合并为实信号频谱
+        const auto z0 = memory[0];
+        memory[0]     = {z0.re + z0.im, 0};
+        memory[_half] = {z0.re - z0.im, 0};
+        for (size_t k = 1; k <= _half / 2; ++k) {
+            const auto a = memory[k],
+                       b = memory[_half - k].conjugate(),
+                       e = (a + b) * .5f,
+                       o = (a - b) * complex_t{0, -.5f},
+                       t = _twiddles[k] * o;
+            memory[k]         = e + t;
+            memory[_half - k] = (e - t).conjugate();
         }
     }
+    
+    /// 原地反变换（含 1/n 归一化）：n/2+1 个频点 -> 成对存放的实信号
+    void inverse(complex_t *memory) const {
+        // 由实信号频谱恢复奇偶两路频谱
+        const auto x0 = memory[0].re,
+                   xn = memory[_half].re;
+        memory[0] = {(x0 + xn) * .5f, (x0 - xn) * .5f};
+        for (size_t k = 1; k <= _half / 2; ++k) {
+            const auto a = memory[k],
+                       b = memory[_half - k].conjugate(),
+                       e = (a + b) * .5f,
+                       o = (a - b) * _twiddles[k].conjugate() * .5f,
+                       z = e + o * complex_t{0, 1};
+            memory[k]         = z;
+            memory[_half - k] = e.conjugate() + o.conjugate() * complex_t{0, 1};
+        }
+        
+        _plan.inverse(memory);
+    }
+    
+    /// 原地正变换，分离存储：re[i] = x[2i]，im[i] = x[2i+1] -> n/2+1 个频点
+    void forward(float *re, float *im) const {
+        _plan.forward(re, im);
+        
+        const auto r0 = re[0], i0 = im[0];
+        re[0]     = r0 + i0;
+        im[0]     = 0;
+        re[_half] = r0 - i0;
+        im[_half] = 0;
+        for (size_t k = 1; k <= _half / 2; ++k) {
+            const auto a = complex_t{re[k], im[k]},
+                       b = complex_t{re[_half - k], -im[_half - k]},
+                       e = (a + b) * .5f,
+                       o = (a - b) * complex_t{0, -.5f},
+                       t = _twiddles[k] * o;
+            re[k]         = e.re + t.re;
+            im[k]         = e.im + t.im;
+            re[_half - k] = e.re - t.re;
+            im[_half - k] = t.im - e.im;
+        }
+    }
+    
+    /// 原地反变换（含 1/n 归一化），分离存储：n/2+1 个频点 -> re[i] = x[2i]，im[i] = x[2i+1]
+    void inverse(float *re, float *im) const {
+        const auto x0 = re[0],
+                   xn = re[_half];
+        re[0] = (x0 + xn) * .5f;
+        im[0] = (x0 - xn) * .5f;
+        for (size_t k = 1; k <= _half / 2; ++k) {
+            const auto a = complex_t{re[k], im[k]},
+                       b = complex_t{re[_half - k], -im[_half - k]},
+                       e = (a + b) * .5f,
+                       o = (a - b) * _twiddles[k].conjugate() * .5f;
+            re[k]         = e.re - o.im;
+            im[k]         = e.im + o.re;
+            re[_half - k] = e.re + o.im;
+            im[_half - k] = o.re - e.im;
+        }
+        
+        _plan.inverse(re, im);
+    }
+};
+
+/**
+ * 按长度缓存的变换计划表
+ * @remarks 运行时长度的变换由此获取计划，同一长度只构造一次；加锁保证多线程下安全。
+ *          计划在程序结束前不会释放，返回的引用始终有效。
+ * @tparam plan_t 计划类型，须能由长度构造
+ * @param n 变换长度
+ * @return 共享的变换计划
+ */
+template<class plan_t>
+plan_t const &cached_plan(size_t n) {
+    static std::mutex                                         mutex;
+    static std::unordered_map<size_t, std::unique_ptr<plan_t>> plans;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    auto &plan = plans[n];
+    if (!plan) plan = std::make_unique<plan_t>(n);
+    return *plan;
 }
 
-/// 基 2 快速傅里叶反变换
+/**
+ * 固定长度的 FFT 变换计划
+ * @tparam _n 变换长度
+ */
+template<auto _n>
+class fft_plan : public fft_plan_t {
+    static_assert(_n > 0, "size is 0");
+    
+    fft_plan() : fft_plan_t(_n) {}
+
+public:
+    /// 获取该长度共享的变换计划
+    static fft_plan const &instance() {
+        static const fft_plan plan;
+        return plan;
+    }
+};
+
+/**
+ * 固定长度的实信号 FFT 变换计划
+ * @tparam _n 实信号长度，必须是不小于 2 的偶数
+ */
+template<auto _n>
+class rfft_plan : public rfft_plan_t {
+    static_assert(_n >= 2 && _n % 2 == 0, "size is not even");
+    
+    rfft_plan() : rfft_plan_t(_n) {}
+
+public:
+    /// 获取该长度共享的变换计划
+    static rfft_plan const &instance() {
+        static const rfft_plan plan;
+        return plan;
+    }
+};
+
+/// 快速傅里叶正变换
+template<auto _n>
+void fft(complex_t memory[_n]) {
+    fft_plan<_n>::instance().forward(memory);
+}
+
+/// 快速傅里叶反变换
 template<auto _n>
 void ifft(complex_t memory[_n]) {
-    fft<_n>(memory, omega_inverse<_n>);
-    for (auto p = memory; p < memory + _n; ++p)
-        *p /= _n;
+    fft_plan<_n>::instance().inverse(memory);
+}
+
+/// 快速傅里叶正变换（运行时长度）
+inline void fft(complex_t *memory, size_t n) {
+    cached_plan<fft_plan_t>(n).forward(memory);
+}
+
+/// 快速傅里叶反变换（运行时长度）
+inline void ifft(complex_t *memory, size_t n) {
+    cached_plan<fft_plan_t>(n).inverse(memory);
+}
+
+/// 快速傅里叶正变换，分离存储
+template<auto _n>
+void fft(split_complex_t &memory) {
+    fft_plan<_n>::instance().forward(memory.re.data(), memory.im.data());
+}
+
+/// 快速傅里叶反变换，分离存储
+template<auto _n>
+void ifft(split_complex_t &memory) {
+    fft_plan<_n>::instance().inverse(memory.re.data(), memory.im.data());
+}
+
+/// 快速傅里叶正变换，分离存储（运行时长度，取序列长度）
+inline void fft(split_complex_t &memory) {
+    cached_plan<fft_plan_t>(memory.size()).forward(memory.re.data(), memory.im.data());
+}
+
+/// 快速傅里叶反变换，分离存储（运行时长度，取序列长度）
+inline void ifft(split_complex_t &memory) {
+    cached_plan<fft_plan_t>(memory.size()).inverse(memory.re.data(), memory.im.data());
 }
 
 #endif //FFT_FFT_H
@@ -0,0 +1,685 @@
+#ifndef SIMULATION_FFT_KERNEL_H
+#define SIMULATION_FFT_KERNEL_H
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+#include "../signal/complex_t.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FFT_KERNEL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// 按指令集分派的入口带 target 属性；各级模板强制内联进入口，
+// 否则不优化编译时它们作为普通函数与带 target 的向量操作之间以不同的调用约定传递向量寄存器
+#if defined(__GNUC__) || defined(__clang__)
+#define FFT_KERNEL_TARGET(ISA) __attribute__((target(ISA), flatten))
+#define FFT_KERNEL_INLINE __attribute__((always_inline))
+#else
+#define FFT_KERNEL_TARGET(ISA)
+#define FFT_KERNEL_INLINE
+#endif
+
+/**
+ * FFT 蝶形运算内核
+ * @remarks 基 4 按时间抽选（输入已错序），log2(n) 为奇数时先做一级基 2。
+ *          每级基 4 的旋转因子连续存放为 [ω^j][ω^2j][ω^3j]（ω = ω<4m,1>，0 <= j < m），
+ *          便于向量化加载。x86 上运行时按 CPUID 在 SSE2 / AVX2 / AVX-512 间选择，其他平台使用标量实现。
+ *          同时提供交错存储（complex_t）和分离存储（实部、虚部各自连续）两种数据布局的内核。
+ *          非 2 的整数次幂长度使用 4/2/3/5/7 混合基内核。
+ */
+namespace fft_kernel {
+    /// 向量指令集级别
+    enum class simd_level { scalar, sse2, avx2, avx512 };
+    
+    /// 检测处理器支持的最高指令集级别
+    inline simd_level detect_simd() {
+#if defined(FFT_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return simd_level::avx512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return simd_level::avx2;
+        if (__builtin_cpu_supports("sse2")) return simd_level::sse2;
+        return simd_level::scalar;
+#elif defined(FFT_KERNEL_X86)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return simd_level::sse2;
+        
+        __cpuid(info, 1);
+        const bool     fma  = info[2] & (1 << 12),
+                       os   = info[2] & (1 << 27);
+        const auto     xcr0 = os ? _xgetbv(0) : 0;
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 16)) && (xcr0 & 0xe6) == 0xe6) return simd_level::avx512;
+        if ((info[1] & (1 << 5)) && fma && (xcr0 & 6) == 6) return simd_level::avx2;
+        return simd_level::sse2;
+#else
+        return simd_level::scalar;
+#endif
+    }
+    
+    /// 当前使用的指令集级别（可以调低，用于对照或复现）
+    inline simd_level &active_simd() {
+        static simd_level level = detect_simd();
+        return level;
+    }
+    
+    /// 构造基 4 各级的旋转因子表
+    inline std::vector<complex_t> build_twiddles(size_t n) {
+        std::vector<complex_t> twiddles;
+        
+        size_t m = 1;
+        for (auto k = n; k > 1; k >>= 2u)
+            if (k == 2) m = 2;
+        for (; m < n; m <<= 2u)
+            for (size_t p = 1; p <= 3; ++p)
+                for (size_t j = 0; j < m; ++j) {
+                    auto theta = M_PI * p * j / (2 * m);
+                    twiddles.push_back({static_cast<float>(std::cos(theta)),
+                                        static_cast<float>(std::sin(theta))});
+                }
+        return twiddles;
+    }
+    
+    /// 标量“向量”，宽度为 1
+    struct scalar_t {
+        using reg = complex_t;
+        constexpr static size_t width = 1;
+        
+        static inline reg load(complex_t const *p) { return *p; }
+        
+        static inline void store(complex_t *p, reg a) { *p = a; }
+        
+        static inline reg add(reg a, reg b) { return a + b; }
+        
+        static inline reg sub(reg a, reg b) { return a - b; }
+        
+        static inline reg mul(reg a, reg w) { return a * w; }
+        
+        static inline reg mul_conj(reg a, reg w) { return a * w.conjugate(); }
+        
+        static inline reg rot(reg a) { return {-a.im, a.re}; }
+        
+        static inline reg rot_neg(reg a) { return {a.im, -a.re}; }
+    };
+    
+    /// 分离存储用的标量“向量”，宽度为 1
+    struct scalar_split_t {
+        using reg = float;
+        constexpr static size_t width = 1;
+        
+        static inline reg load(float const *p) { return *p; }
+        
+        static inline void store(float *p, reg a) { *p = a; }
+        
+        static inline reg add(reg a, reg b) { return a + b; }
+        
+        static inline reg sub(reg a, reg b) { return a - b; }
+        
+        static inline reg mul(reg a, reg b) { return a * b; }
+    };
+
+#ifdef FFT_KERNEL_X86
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+    
+    struct sse2_t {
+        using reg = __m128;
+        constexpr static size_t width = 2;
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg sign_even() { return _mm_castsi128_ps(_mm_set_epi32(0, INT32_MIN, 0, INT32_MIN)); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg sign_odd() { return _mm_castsi128_ps(_mm_set_epi32(INT32_MIN, 0, INT32_MIN, 0)); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg swap(reg a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg load(complex_t const *p) { return _mm_loadu_ps(&p->re); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline void store(complex_t *p, reg a) { _mm_storeu_ps(&p->re, a); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg mul(reg a, reg w) {
+            const auto wr = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0)),
+                       wi = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1));
+            return _mm_add_ps(_mm_mul_ps(a, wr), _mm_xor_ps(_mm_mul_ps(swap(a), wi), sign_even()));
+        }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg mul_conj(reg a, reg w) {
+            const auto wr = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0)),
+                       wi = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1));
+            return _mm_add_ps(_mm_mul_ps(a, wr), _mm_xor_ps(_mm_mul_ps(swap(a), wi), sign_odd()));
+        }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg rot(reg a) { return _mm_xor_ps(swap(a), sign_even()); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg rot_neg(reg a) { return _mm_xor_ps(swap(a), sign_odd()); }
+    };
+    
+    struct avx2_t {
+        using reg = __m256;
+        constexpr static size_t width = 4;
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg sign_even() { return _mm256_castsi256_ps(_mm256_set1_epi64x(0x80000000ll)); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg sign_odd() { return _mm256_castsi256_ps(_mm256_set1_epi64x(INT64_MIN)); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg swap(reg a) { return _mm256_permute_ps(a, 0xb1); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg load(complex_t const *p) { return _mm256_loadu_ps(&p->re); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline void store(complex_t *p, reg a) { _mm256_storeu_ps(&p->re, a); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg mul(reg a, reg w) {
+            return _mm256_fmaddsub_ps(a, _mm256_moveldup_ps(w), _mm256_mul_ps(swap(a), _mm256_movehdup_ps(w)));
+        }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg mul_conj(reg a, reg w) {
+            return _mm256_fmsubadd_ps(a, _mm256_moveldup_ps(w), _mm256_mul_ps(swap(a), _mm256_movehdup_ps(w)));
+        }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg rot(reg a) { return _mm256_xor_ps(swap(a), sign_even()); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg rot_neg(reg a) { return _mm256_xor_ps(swap(a), sign_odd()); }
+    };
+    
+    struct avx512_t {
+        using reg = __m512;
+        constexpr static size_t width = 8;
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg xor_mask(reg a, long long mask) {
+            return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi64(mask)));
+        }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg swap(reg a) { return _mm512_shuffle_ps(a, a, 0xb1); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg load(complex_t const *p) { return _mm512_loadu_ps(&p->re); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline void store(complex_t *p, reg a) { _mm512_storeu_ps(&p->re, a); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg mul(reg a, reg w) {
+            return _mm512_fmaddsub_ps(a, _mm512_shuffle_ps(w, w, 0xa0), _mm512_mul_ps(swap(a), _mm512_shuffle_ps(w, w, 0xf5)));
+        }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg mul_conj(reg a, reg w) {
+            return _mm512_fmsubadd_ps(a, _mm512_shuffle_ps(w, w, 0xa0), _mm512_mul_ps(swap(a), _mm512_shuffle_ps(w, w, 0xf5)));
+        }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg rot(reg a) { return xor_mask(swap(a), 0x80000000ll); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg rot_neg(reg a) { return xor_mask(swap(a), INT64_MIN); }
+    };
+    
+    struct sse2_split_t {
+        using reg = __m128;
+        constexpr static size_t width = 4;
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg load(float const *p) { return _mm_loadu_ps(p); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline void store(float *p, reg a) { _mm_storeu_ps(p, a); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("sse2")
+        static inline reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+    };
+    
+    struct avx2_split_t {
+        using reg = __m256;
+        constexpr static size_t width = 8;
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg load(float const *p) { return _mm256_loadu_ps(p); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline void store(float *p, reg a) { _mm256_storeu_ps(p, a); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("avx2,fma")
+        static inline reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    };
+    
+    struct avx512_split_t {
+        using reg = __m512;
+        constexpr static size_t width = 16;
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg load(float const *p) { return _mm512_loadu_ps(p); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline void store(float *p, reg a) { _mm512_storeu_ps(p, a); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+        
+        FFT_KERNEL_TARGET("avx512f")
+        static inline reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+    };
+
+#endif // FFT_KERNEL_X86
+    
+    /// 一级基 4 蝶形运算，跨度 m
+    template<class vec_t, bool _inverse>
+    FFT_KERNEL_INLINE inline void radix4_pass(complex_t *memory, size_t n, size_t m, complex_t const *twiddles) {
+        if constexpr (vec_t::width > 1)
+            if (m < vec_t::width) {
+                radix4_pass<scalar_t, _inverse>(memory, n, m, twiddles);
+                return;
+            }
+        
+        const auto w1 = twiddles, w2 = w1 + m, w3 = w2 + m;
+        for (auto  a  = memory; a < memory + n; a += 4 * m)
+            for (size_t j = 0; j < m; j += vec_t::width) {
+                typename vec_t::reg x0, u1, u2, u3;
+                x0 = vec_t::load(a + j);
+                if constexpr (_inverse) {
+                    u1 = vec_t::mul_conj(vec_t::load(a + j + m), vec_t::load(w2 + j));
+                    u2 = vec_t::mul_conj(vec_t::load(a + j + 2 * m), vec_t::load(w1 + j));
+                    u3 = vec_t::mul_conj(vec_t::load(a + j + 3 * m), vec_t::load(w3 + j));
+                } else {
+                    u1 = vec_t::mul(vec_t::load(a + j + m), vec_t::load(w2 + j));
+                    u2 = vec_t::mul(vec_t::load(a + j + 2 * m), vec_t::load(w1 + j));
+                    u3 = vec_t::mul(vec_t::load(a + j + 3 * m), vec_t::load(w3 + j));
+                }
+                
+                const auto s0 = vec_t::add(x0, u1),
+                           d0 = vec_t::sub(x0, u1),
+                           s1 = vec_t::add(u2, u3),
+                           d1 = _inverse ? vec_t::rot_neg(vec_t::sub(u2, u3))
+                                         : vec_t::rot(vec_t::sub(u2, u3));
+                vec_t::store(a + j, vec_t::add(s0, s1));
+                vec_t::store(a + j + m, vec_t::add(d0, d1));
+                vec_t::store(a + j + 2 * m, vec_t::sub(s0, s1));
+                vec_t::store(a + j + 3 * m, vec_t::sub(d0, d1));
+            }
+    }
+    
+    /// 对已错序的数据完成全部蝶形运算
+    template<class vec_t, bool _inverse>
+    FFT_KERNEL_INLINE inline void transform(complex_t *memory, size_t n, complex_t const *twiddles) {
+        size_t m = 1;
+        for (auto k = n; k > 1; k >>= 2u)
+            if (k == 2) m = 2;
+        
+        if (m == 2)
+            for (auto a = memory; a < memory + n; a += 2) {
+                const auto t = a[1];
+                a[1] = a[0] - t;
+                a[0] += t;
+            }
+        
+        for (; m < n; m <<= 2u) {
+            radix4_pass<vec_t, _inverse>(memory, n, m, twiddles);
+            twiddles += 3 * m;
+        }
+    }
+    
+    /// 分离存储的复数乘（反变换时乘以旋转因子的共轭）
+    template<class vec_t, bool _inverse>
+    FFT_KERNEL_INLINE inline void multiply(
+        typename vec_t::reg const &ar, typename vec_t::reg const &ai,
+        typename vec_t::reg const &wr, typename vec_t::reg const &wi,
+        typename vec_t::reg &r, typename vec_t::reg &i
+    ) {
+        if constexpr (_inverse) {
+            r = vec_t::add(vec_t::mul(ar, wr), vec_t::mul(ai, wi));
+            i = vec_t::sub(vec_t::mul(ai, wr), vec_t::mul(ar, wi));
+        } else {
+            r = vec_t::sub(vec_t::mul(ar, wr), vec_t::mul(ai, wi));
+            i = vec_t::add(vec_t::mul(ar, wi), vec_t::mul(ai, wr));
+        }
+    }
+    
+    /// 一级基 4 蝶形运算，跨度 m，分离存储
+    template<class vec_t, bool _inverse>
+    FFT_KERNEL_INLINE inline void radix4_pass(
+        float *re, float *im, size_t n, size_t m,
+        float const *twiddles_re, float const *twiddles_im
+    ) {
+        if constexpr (vec_t::width > 1)
+            if (m < vec_t::width) {
+                radix4_pass<scalar_split_t, _inverse>(re, im, n, m, twiddles_re, twiddles_im);
+                return;
+            }
+        
+        using reg = typename vec_t::reg;
+        
+        const auto w1r = twiddles_re, w2r = w1r + m, w3r = w2r + m,
+                   w1i = twiddles_im, w2i = w1i + m, w3i = w2i + m;
+        for (size_t g = 0; g < n; g += 4 * m) {
+            const auto ar = re + g, ai = im + g;
+            for (size_t j = 0; j < m; j += vec_t::width) {
+                const auto x0r = vec_t::load(ar + j),
+                           x0i = vec_t::load(ai + j);
+                reg        u1r, u1i, u2r, u2i, u3r, u3i;
+                multiply<vec_t, _inverse>(vec_t::load(ar + j + m), vec_t::load(ai + j + m),
+                                          vec_t::load(w2r + j), vec_t::load(w2i + j), u1r, u1i);
+                multiply<vec_t, _inverse>(vec_t::load(ar + j + 2 * m), vec_t::load(ai + j + 2 * m),
+                                          vec_t::load(w1r + j), vec_t::load(w1i + j), u2r, u2i);
+                multiply<vec_t, _inverse>(vec_t::load(ar + j + 3 * m), vec_t::load(ai + j + 3 * m),
+                                          vec_t::load(w3r + j), vec_t::load(w3i + j), u3r, u3i);
+                
+                const auto s0r = vec_t::add(x0r, u1r), s0i = vec_t::add(x0i, u1i),
+                           d0r = vec_t::sub(x0r, u1r), d0i = vec_t::sub(x0i, u1i),
+                           s1r = vec_t::add(u2r, u3r), s1i = vec_t::add(u2i, u3i),
+                           d1r = vec_t::sub(u2r, u3r), d1i = vec_t::sub(u2i, u3i);
+                vec_t::store(ar + j, vec_t::add(s0r, s1r));
+                vec_t::store(ai + j, vec_t::add(s0i, s1i));
+                vec_t::store(ar + j + 2 * m, vec_t::sub(s0r, s1r));
+                vec_t::store(ai + j + 2 * m, vec_t::sub(s0i, s1i));
+                // 正变换 d1 乘 j，反变换乘 -j
+                if constexpr (_inverse) {
+                    vec_t::store(ar + j + m, vec_t::add(d0r, d1i));
+                    vec_t::store(ai + j + m, vec_t::sub(d0i, d1r));
+                    vec_t::store(ar + j + 3 * m, vec_t::sub(d0r, d1i));
+                    vec_t::store(ai + j + 3 * m, vec_t::add(d0i, d1r));
+                } else {
+                    vec_t::store(ar + j + m, vec_t::sub(d0r, d1i));
+                    vec_t::store(ai + j + m, vec_t::add(d0i, d1r));
+                    vec_t::store(ar + j + 3 * m, vec_t::add(d0r, d1i));
+                    vec_t::store(ai + j + 3 * m, vec_t::sub(d0i, d1r));
+                }
+            }
+        }
+    }
+    
+    /// 对已错序的分离存储数据完成全部蝶形运算
+    template<class vec_t, bool _inverse>
+    FFT_KERNEL_INLINE inline void transform(
+        float *re, float *im, size_t n,
+        float const *twiddles_re, float const *twiddles_im
+    ) {
+        size_t m = 1;
+        for (auto k = n; k > 1; k >>= 2u)
+            if (k == 2) m = 2;
+        
+        if (m == 2)
+            for (size_t i = 0; i < n; i += 2) {
+                const auto tr = re[i + 1], ti = im[i + 1];
+                re[i + 1] = re[i] - tr;
+                im[i + 1] = im[i] - ti;
+                re[i] += tr;
+                im[i] += ti;
+            }
+        
+        for (size_t offset = 0; m < n; offset += 3 * m, m <<= 2u)
+            radix4_pass<vec_t, _inverse>(re, im, n, m, twiddles_re + offset, twiddles_im + offset);
+    }
+    
+    inline void run_scalar(complex_t *memory, size_t n, complex_t const *twiddles, bool inverse) {
+        inverse ? transform<scalar_t, true>(memory, n, twiddles)
+                : transform<scalar_t, false>(memory, n, twiddles);
+    }
+    
+    inline void run_scalar(
+        float *re, float *im, size_t n,
+        float const *twiddles_re, float const *twiddles_im, bool inverse
+    ) {
+        inverse ? transform<scalar_split_t, true>(re, im, n, twiddles_re, twiddles_im)
+                : transform<scalar_split_t, false>(re, im, n, twiddles_re, twiddles_im);
+    }
+
+#ifdef FFT_KERNEL_X86
+    FFT_KERNEL_TARGET("sse2")
+    inline void run_sse2(complex_t *memory, size_t n, complex_t const *twiddles, bool inverse) {
+        inverse ? transform<sse2_t, true>(memory, n, twiddles)
+                : transform<sse2_t, false>(memory, n, twiddles);
+    }
+    
+    FFT_KERNEL_TARGET("sse2")
+    inline void run_sse2(
+        float *re, float *im, size_t n,
+        float const *twiddles_re, float const *twiddles_im, bool inverse
+    ) {
+        inverse ? transform<sse2_split_t, true>(re, im, n, twiddles_re, twiddles_im)
+                : transform<sse2_split_t, false>(re, im, n, twiddles_re, twiddles_im);
+    }
+    
+    FFT_KERNEL_TARGET("avx2,fma")
+    inline void run_avx2(complex_t *memory, size_t n, complex_t const *twiddles, bool inverse) {
+        inverse ? transform<avx2_t, true>(memory, n, twiddles)
+                : transform<avx2_t, false>(memory, n, twiddles);
+    }
+    
+    FFT_KERNEL_TARGET("avx2,fma")
+    inline void run_avx2(
+        float *re, float *im, size_t n,
+        float const *twiddles_re, float const *twiddles_im, bool inverse
+    ) {
+        inverse ? transform<avx2_split_t, true>(re, im, n, twiddles_re, twiddles_im)
+                : transform<avx2_split_t, false>(re, im, n, twiddles_re, twiddles_im);
+    }
+    
+    FFT_KERNEL_TARGET("avx512f")
+    inline void run_avx512(complex_t *memory, size_t n, complex_t const *twiddles, bool inverse) {
+        inverse ? transform<avx512_t, true>(memory, n, twiddles)
+                : transform<avx512_t, false>(memory, n, twiddles);
+    }
+    
+    FFT_KERNEL_TARGET("avx512f")
+    inline void run_avx512(
+        float *re, float *im, size_t n,
+        float const *twiddles_re, float const *twiddles_im, bool inverse
+    ) {
+        inverse ? transform<avx512_split_t, true>(re, im, n, twiddles_re, twiddles_im)
+                : transform<avx512_split_t, false>(re, im, n, twiddles_re, twiddles_im);
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // FFT_KERNEL_X86
+    
+    /**
+     * 按当前指令集级别执行蝶形运算
+     * @param memory 已错序的数据
+     * @param n 变换长度，必须是 2 的整数次幂
+     * @param twiddles 来自 `build_twiddles(n)` 的旋转因子表
+     * @param inverse 是否反变换（不含归一化）
+     */
+    inline void run(complex_t *memory, size_t n, complex_t const *twiddles, bool inverse) {
+        switch (active_simd()) {
+#ifdef FFT_KERNEL_X86
+            case simd_level::avx512:
+                run_avx512(memory, n, twiddles, inverse);
+                break;
+            case simd_level::avx2:
+                run_avx2(memory, n, twiddles, inverse);
+                break;
+            case simd_level::sse2:
+                run_sse2(memory, n, twiddles, inverse);
+                break;
+#endif
+            default:
+                run_scalar(memory, n, twiddles, inverse);
+                break;
+        }
+    }
+    
+    /**
+     * 按当前指令集级别执行蝶形运算，分离存储
+     * @param re 已错序数据的实部
+     * @param im 已错序数据的虚部
+     * @param n 变换长度，必须是 2 的整数次幂
+     * @param twiddles_re 旋转因子表实部
+     * @param twiddles_im 旋转因子表虚部
+     * @param inverse 是否反变换（不含归一化）
+     */
+    inline void run(
+        float *re, float *im, size_t n,
+        float const *twiddles_re, float const *twiddles_im, bool inverse
+    ) {
+        switch (active_simd()) {
+#ifdef FFT_KERNEL_X86
+            case simd_level::avx512:
+                run_avx512(re, im, n, twiddles_re, twiddles_im, inverse);
+                break;
+            case simd_level::avx2:
+                run_avx2(re, im, n, twiddles_re, twiddles_im, inverse);
+                break;
+            case simd_level::sse2:
+                run_sse2(re, im, n, twiddles_re, twiddles_im, inverse);
+                break;
+#endif
+            default:
+                run_scalar(re, im, n, twiddles_re, twiddles_im, inverse);
+                break;
+        }
+    }
+    
+    /// 把变换长度分解为 4、2、3、5、7 的乘积，无法分解时返回空表
+    inline std::vector<size_t> factorize(size_t n) {
+        std::vector<size_t> factors;
+        for (size_t         p : {4, 2, 3, 5, 7})
+            while (n % p == 0) {
+                factors.push_back(p);
+                n /= p;
+            }
+        if (n != 1) factors.clear();
+        return factors;
+    }
+    
+    /// 混合基蝶形运算，基 2
+    inline void butterfly2(complex_t *out, size_t stride, size_t m, complex_t const *roots) {
+        for (size_t k = 0; k < m; ++k) {
+            const auto t = out[k + m] * roots[k * stride];
+            out[k + m] = out[k] - t;
+            out[k] += t;
+        }
+    }
+    
+    /// 混合基蝶形运算，基 4
+    inline void butterfly4(complex_t *out, size_t stride, size_t m, complex_t const *roots) {
+        for (size_t k = 0; k < m; ++k) {
+            const auto u1 = out[k + m] * roots[k * stride],
+                       u2 = out[k + 2 * m] * roots[2 * k * stride],
+                       u3 = out[k + 3 * m] * roots[3 * k * stride],
+                       s0 = out[k] + u2,
+                       d0 = out[k] - u2,
+                       s1 = u1 + u3,
+                       d1 = scalar_t::rot(u1 - u3);
+            out[k]         = s0 + s1;
+            out[k + m]     = d0 + d1;
+            out[k + 2 * m] = s0 - s1;
+            out[k + 3 * m] = d0 - d1;
+        }
+    }
+    
+    /// 混合基蝶形运算，任意小基数（用于 3、5、7）
+    inline void butterfly(complex_t *out, size_t stride, size_t m, size_t p, complex_t const *roots, size_t n) {
+        complex_t scratch[8];
+        for (size_t u = 0; u < m; ++u) {
+            for (size_t q = 0; q < p; ++q) scratch[q] = out[u + q * m];
+            for (size_t q = 0, k = u; q < p; ++q, k += m) {
+                auto      sum   = scratch[0];
+                size_t    index = 0;
+                for (size_t r     = 1; r < p; ++r) {
+                    index += stride * k;
+                    if (index >= n) index %= n;
+                    sum += scratch[r] * roots[index];
+                }
+                out[k] = sum;
+            }
+        }
+    }
+    
+    /**
+     * 混合基按时间抽选变换（递归，异地）
+     * @param out 输出，连续 `length` 点
+     * @param in 输入，间隔 `stride` 取点
+     * @param stride 输入间隔，同时是旋转因子表的间隔
+     * @param factors 剩余的基数表
+     * @param length 本层变换长度
+     * @param roots ω<n,k>，0 <= k < n
+     * @param n 总变换长度
+     */
+    inline void mixed_radix(
+        complex_t *out, complex_t const *in, size_t stride,
+        size_t const *factors, size_t length,
+        complex_t const *roots, size_t n
+    ) {
+        const auto p = *factors, m = length / p;
+        if (m == 1)
+            for (size_t q = 0; q < p; ++q) out[q] = in[q * stride];
+        else
+            for (size_t q = 0; q < p; ++q)
+                mixed_radix(out + q * m, in + q * stride, stride * p, factors + 1, m, roots, n);
+        
+        switch (p) {
+            case 2:
+                butterfly2(out, stride, m, roots);
+                break;
+            case 4:
+                butterfly4(out, stride, m, roots);
+                break;
+            default:
+                butterfly(out, stride, m, p, roots, n);
+                break;
+        }
+    }
+}
+
+#endif // SIMULATION_FFT_KERNEL_H
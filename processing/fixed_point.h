@@ -0,0 +1,432 @@
+#ifndef SIMULATION_FIXED_POINT_H
+#define SIMULATION_FIXED_POINT_H
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "fft.h"
+#include "fft_kernel.h"
+#include "static_check.h"
+
+/**
+ * 定点数
+ * @remarks 以 `storage_t` 存放 raw，值为 raw / 2^_fraction。
+ *          加减乘都先在两倍宽度的整数上计算，乘法四舍五入，结果饱和到存储类型的范围，
+ *          与 DSP/MCU 上的饱和指令行为一致。
+ * @tparam _fraction 小数位数
+ * @tparam storage_t 存储类型，有符号整数
+ */
+template<unsigned _fraction, class storage_t = int16_t>
+struct fixed_t {
+    static_assert(std::is_signed_v<storage_t> && _fraction < 8 * sizeof(storage_t));
+    
+    using wide_t = std::conditional_t<sizeof(storage_t) < 4, int32_t, int64_t>;
+    
+    constexpr static wide_t one     = wide_t{1} << _fraction;
+    constexpr static wide_t minimum = std::numeric_limits<storage_t>::min(),
+                            maximum = std::numeric_limits<storage_t>::max();
+    
+    storage_t raw;
+    
+    /// 饱和到存储范围
+    constexpr static fixed_t saturate(wide_t x) {
+        return {static_cast<storage_t>(std::clamp(x, minimum, maximum))};
+    }
+    
+    /// 由浮点数构造（四舍五入，饱和）
+    static fixed_t from_float(float x) {
+        const auto scaled = std::round(static_cast<double>(x) * one);
+        return saturate(static_cast<wide_t>(std::clamp<double>(scaled, minimum, maximum)));
+    }
+    
+    [[nodiscard]]
+    float to_float() const {
+        return static_cast<float>(raw) / one;
+    }
+    
+    fixed_t operator+(fixed_t others) const { return saturate(wide_t{raw} + others.raw); }
+    
+    fixed_t operator-(fixed_t others) const { return saturate(wide_t{raw} - others.raw); }
+    
+    fixed_t operator-() const { return saturate(-wide_t{raw}); }
+    
+    fixed_t operator*(fixed_t others) const {
+        return saturate((wide_t{raw} * others.raw + (one >> 1u)) >> _fraction);
+    }
+    
+    auto operator<=>(fixed_t const &) const = default;
+};
+
+using q15_t = fixed_t<15>;
+using q31_t = fixed_t<31, int32_t>;
+
+static_assert(sizeof(q15_t) == sizeof(int16_t), "q15_t must be a bare int16_t");
+
+/**
+ * 把浮点信号量化为定点信号
+ * @tparam fixed_t 定点类型
+ * @param signal 原信号
+ * @param full_scale 满量程，映射到定点数的 1
+ * @return 定点信号，超出满量程的点饱和
+ */
+template<class fixed_t>
+std::vector<fixed_t> quantize(std::vector<float> const &signal, float full_scale = 1) {
+    std::vector<fixed_t> result(signal.size());
+    std::transform(signal.begin(), signal.end(), result.begin(),
+                   [k = 1 / full_scale](float x) { return fixed_t::from_float(x * k); });
+    return result;
+}
+
+/**
+ * 模拟 AD 采样：按 `bits` 位量化，左对齐存放为 Q15
+ * @param signal 原信号
+ * @param bits AD 位数（不超过 16）
+ * @param full_scale AD 满量程
+ * @return Q15 信号，低 16 - bits 位为 0
+ */
+inline std::vector<q15_t> adc_quantize(std::vector<float> const &signal, unsigned bits = 12, float full_scale = 1) {
+    const auto shift = 16 - std::clamp(bits, 1u, 16u);
+    const auto step  = 1 << shift;
+    
+    auto result = quantize<q15_t>(signal, full_scale);
+    for (auto &x : result) {
+        const auto rounded = (static_cast<int32_t>(x.raw) + step / 2) >> shift << shift;
+        x = q15_t::saturate(rounded);
+    }
+    return result;
+}
+
+/**
+ * 把定点信号还原为浮点信号
+ * @param signal 定点信号
+ * @param exponent 块指数，值为 raw / 2^_fraction · 2^exponent
+ * @param full_scale 满量程
+ */
+template<class fixed_t>
+std::vector<float> dequantize(std::vector<fixed_t> const &signal, int exponent = 0, float full_scale = 1) {
+    const auto k = std::ldexp(full_scale, exponent);
+    
+    std::vector<float> result(signal.size());
+    std::transform(signal.begin(), signal.end(), result.begin(),
+                   [k](fixed_t x) { return x.to_float() * k; });
+    return result;
+}
+
+/**
+ * 块浮点 Q15 复序列（分离存储）
+ * @remarks 所有点共享一个块指数：第 i 点的值为 (re[i], im[i]) / 2^15 · 2^exponent。
+ */
+struct q15_block_t {
+    std::vector<q15_t> re, im;
+    int                exponent = 0;
+    
+    q15_block_t() = default;
+    
+    explicit q15_block_t(size_t size) : re(size, q15_t{0}), im(size, q15_t{0}) {}
+    
+    [[nodiscard]]
+    size_t size() const {
+        return re.size();
+    }
+    
+    /// 还原为浮点复序列
+    [[nodiscard]]
+    std::vector<complex_t> to_complex() const {
+        const auto k = std::ldexp(1.0f, exponent);
+        
+        std::vector<complex_t> result(size());
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = {re[i].to_float() * k, im[i].to_float() * k};
+        return result;
+    }
+};
+
+/**
+ * Q15 块浮点 FFT 变换计划
+ * @remarks 基 2 按时间抽取，长度必须是 2 的整数次幂，旋转因子为 Q15。
+ *          每级蝶形前检查上一级输出的最大幅值，超过 32767 / (1 + √2) 时整体右移一位并计入块指数，
+ *          保证蝶形输出不溢出；右移和乘法都四舍五入，极端情况下由饱和兜底。
+ *          与 `fft_plan_t` 相同，正变换取 e^{+j} 核，反变换含 1/n（计入块指数）。
+ *          x86 上半长不小于 4 的各级蝶形以 SSE2 每次计算 4 个（按 `fft_kernel::active_simd()` 选择），
+ *          乘加用 16 位乘、32 位累加指令完成，结果与标量实现逐位一致；其他平台和前两级使用标量实现。
+ */
+class q15_fft_plan_t {
+    constexpr static int32_t headroom = 13573; // ⌊32767 / (1 + √2)⌋
+    
+    size_t                                     _length;
+    int                                        _log;
+    std::vector<q15_t>                         _cos, _sin; // ω<n,k>，0 <= k < n/2
+    std::vector<int16_t>                       _twiddles;  // 各级 [wr, -wi]... [wi, wr]...，半长 h 的级从 4(h-1) 起
+    std::vector<std::pair<uint32_t, uint32_t>> _swaps;
+    
+    static int32_t magnitude(q15_t const *data, size_t n) {
+        int32_t result = 0;
+        for (size_t i = 0; i < n; ++i) result = std::max(result, std::abs(static_cast<int32_t>(data[i].raw)));
+        return result;
+    }
+    
+    static int16_t round_shift(int32_t x, int shift) {
+        return static_cast<int16_t>(shift ? (x + (1 << (shift - 1))) >> shift : x);
+    }
+
+#ifdef FFT_KERNEL_X86
+    /// 16 位符号扩展为 32 位，再四舍五入右移
+    FFT_KERNEL_TARGET("sse2")
+    static __m128i load_shift(int16_t const *p, __m128i bias, __m128i count) {
+        auto x = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(p));
+        x = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        return _mm_sra_epi32(_mm_add_epi32(x, bias), count);
+    }
+    
+    /// 饱和到 16 位并保存 4 点，同时更新最大幅值
+    FFT_KERNEL_TARGET("sse2")
+    static void store_saturate(int16_t *p, __m128i x, __m128i &peak) {
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(p), _mm_packs_epi32(x, x));
+        const auto sign      = _mm_srai_epi32(x, 31),
+                   magnitude = _mm_sub_epi32(_mm_xor_si128(x, sign), sign),
+                   greater   = _mm_cmpgt_epi32(magnitude, peak);
+        peak = _mm_or_si128(_mm_and_si128(greater, magnitude), _mm_andnot_si128(greater, peak));
+    }
+    
+    /// 一级蝶形（半长不小于 4），每次 4 个，返回本级输出的最大幅值
+    FFT_KERNEL_TARGET("sse2")
+    static int32_t butterflies_sse2(int16_t *re, int16_t *im, size_t n, size_t half, int16_t const *w, int shift) {
+        const auto count = _mm_cvtsi32_si128(shift),
+                   bias  = _mm_set1_epi32(shift ? 1 << (shift - 1) : 0),
+                   round = _mm_set1_epi32(1 << 14);
+        
+        auto peak = _mm_setzero_si128();
+        for (size_t start = 0; start < n; start += 2 * half)
+            for (size_t k = 0; k < half; k += 4) {
+                const auto i  = start + k, j = i + half;
+                const auto ar = load_shift(re + i, bias, count),
+                           ai = load_shift(im + i, bias, count),
+                           br = load_shift(re + j, bias, count),
+                           bi = load_shift(im + j, bias, count);
+                
+                // [br, bi] 交错，与 [wr, -wi]、[wi, wr] 做 16 位乘 32 位累加
+                const auto b  = _mm_unpacklo_epi16(_mm_packs_epi32(br, br), _mm_packs_epi32(bi, bi));
+                const auto tr = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(
+                    b, _mm_loadu_si128(reinterpret_cast<__m128i const *>(w + 2 * k))), round), 15),
+                           ti = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(
+                    b, _mm_loadu_si128(reinterpret_cast<__m128i const *>(w + 2 * (half + k)))), round), 15);
+                
+                store_saturate(re + i, _mm_add_epi32(ar, tr), peak);
+                store_saturate(im + i, _mm_add_epi32(ai, ti), peak);
+                store_saturate(re + j, _mm_sub_epi32(ar, tr), peak);
+                store_saturate(im + j, _mm_sub_epi32(ai, ti), peak);
+            }
+        
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), peak);
+        return std::max({lanes[0], lanes[1], lanes[2], lanes[3]});
+    }
+#endif
+    
+    /// 原地正变换，返回块指数的增量
+    int transform(q15_t *re, q15_t *im) const {
+        for (auto[i, j] : _swaps) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+        
+        int     exponent = 0;
+        int32_t peak     = std::max(magnitude(re, _length), magnitude(im, _length));
+        for (size_t half = 1, step = _length / 2; half < _length; half <<= 1u, step >>= 1u) {
+            int shift = 0;
+            while ((peak >> shift) > headroom) ++shift;
+            exponent += shift;
+
+#ifdef FFT_KERNEL_X86
+            if (half >= 4 && fft_kernel::active_simd() != fft_kernel::simd_level::scalar) {
+                peak = butterflies_sse2(reinterpret_cast<int16_t *>(re), reinterpret_cast<int16_t *>(im),
+                                        _length, half, _twiddles.data() + 4 * (half - 1), shift);
+                continue;
+            }
+#endif
+            peak = 0;
+            
+            for (size_t start = 0; start < _length; start += 2 * half)
+                for (size_t k = 0; k < half; ++k) {
+                    const auto i  = start + k, j = i + half;
+                    const auto wr = static_cast<int32_t>(_cos[k * step].raw),
+                               wi = static_cast<int32_t>(_sin[k * step].raw);
+                    const auto ar = static_cast<int32_t>(round_shift(re[i].raw, shift)),
+                               ai = static_cast<int32_t>(round_shift(im[i].raw, shift)),
+                               br = static_cast<int32_t>(round_shift(re[j].raw, shift)),
+                               bi = static_cast<int32_t>(round_shift(im[j].raw, shift));
+                    const auto tr = (br * wr - bi * wi + (1 << 14)) >> 15,
+                               ti = (br * wi + bi * wr + (1 << 14)) >> 15;
+                    
+                    re[i] = q15_t::saturate(ar + tr);
+                    im[i] = q15_t::saturate(ai + ti);
+                    re[j] = q15_t::saturate(ar - tr);
+                    im[j] = q15_t::saturate(ai - ti);
+                    peak  = std::max({peak,
+                                      std::abs(ar + tr), std::abs(ai + ti),
+                                      std::abs(ar - tr), std::abs(ai - ti)});
+                }
+        }
+        return exponent;
+    }
+
+public:
+    /// 构造 n 点变换计划，n 必须是 2 的整数次幂
+    explicit q15_fft_plan_t(size_t n) : _length(n), _log(0), _cos(n / 2), _sin(n / 2) {
+        if (!check_power_2(n)) throw std::invalid_argument("q15 fft size must be a power of 2");
+        
+        while ((size_t{1} << static_cast<unsigned>(_log)) < n) ++_log;
+        
+        for (size_t k = 0; k < n / 2; ++k) {
+            auto theta = 2 * M_PI * k / n;
+            _cos[k] = q15_t::from_float(static_cast<float>(std::cos(theta)));
+            _sin[k] = q15_t::from_float(static_cast<float>(std::sin(theta)));
+        }
+        
+        // 正变换角度在 [0, π) 内，sin 非负，取负不会溢出
+        _twiddles.reserve(4 * n);
+        for (size_t half = 1, step = n / 2; half < n; half <<= 1u, step >>= 1u) {
+            for (size_t k = 0; k < half; ++k) {
+                _twiddles.push_back(_cos[k * step].raw);
+                _twiddles.push_back(static_cast<int16_t>(-_sin[k * step].raw));
+            }
+            for (size_t k = 0; k < half; ++k) {
+                _twiddles.push_back(_sin[k * step].raw);
+                _twiddles.push_back(_cos[k * step].raw);
+            }
+        }
+        
+        for (uint32_t i = 0, j = 0; i < n; ++i) {
+            if (i < j) _swaps.emplace_back(i, j);
+            auto bit = static_cast<uint32_t>(n >> 1u);
+            for (; j & bit; bit >>= 1u) j ^= bit;
+            j |= bit;
+        }
+    }
+    
+    q15_fft_plan_t(q15_fft_plan_t const &) = delete;
+    
+    q15_fft_plan_t &operator=(q15_fft_plan_t const &) = delete;
+    
+    /// 变换长度
+    [[nodiscard]]
+    size_t size() const {
+        return _length;
+    }
+    
+    /// 原地正变换
+    void forward(q15_block_t &memory) const {
+        memory.exponent += transform(memory.re.data(), memory.im.data());
+    }
+    
+    /// 原地反变换（含 1/n 归一化）：共轭 -> 正变换 -> 共轭
+    void inverse(q15_block_t &memory) const {
+        for (auto &x : memory.im) x = -x;
+        memory.exponent += transform(memory.re.data(), memory.im.data()) - _log;
+        for (auto &x : memory.im) x = -x;
+    }
+};
+
+/// 快速傅里叶正变换，Q15 块浮点（运行时长度，取序列长度）
+inline void fft(q15_block_t &memory) {
+    cached_plan<q15_fft_plan_t>(memory.size()).forward(memory);
+}
+
+/// 快速傅里叶反变换，Q15 块浮点（运行时长度，取序列长度）
+inline void ifft(q15_block_t &memory) {
+    cached_plan<q15_fft_plan_t>(memory.size()).inverse(memory);
+}
+
+/**
+ * 互相关（静态部分），Q15 块浮点
+ * @param signal 原信号
+ * @param plan 变换计划
+ * @return 相关滤波器谱（共 n 点）
+ */
+inline q15_block_t xcorr_init(std::vector<q15_t> const &signal, q15_fft_plan_t const &plan) {
+    q15_block_t filter(plan.size());
+    std::copy(signal.begin(), signal.begin() + std::min(signal.size(), plan.size()), filter.re.begin());
+    plan.forward(filter);
+    for (auto &x : filter.im) x = -x;
+    return filter;
+}
+
+/// 互相关（静态部分），Q15 块浮点（运行时长度，必须是 2 的整数次幂）
+inline q15_block_t xcorr_init(std::vector<q15_t> const &signal, size_t size) {
+    return xcorr_init(signal, cached_plan<q15_fft_plan_t>(size));
+}
+
+/// 互相关（静态部分），Q15 块浮点
+template<auto _size>
+q15_block_t xcorr_init(std::vector<q15_t> const &signal) {
+    static_assert(_size > 0 && (_size & (_size - 1)) == 0, "size is not power of 2");
+    
+    return xcorr_init(signal, cached_plan<q15_fft_plan_t>(_size));
+}
+
+/**
+ * 互相关（动态部分），Q15 块浮点，原地计算
+ * @remarks 与浮点 `xcorr` 相同，对输入谱做 PHAT 白化：每个频点以整数平方根求模，
+ *          除以模长得到单位幅值的 Q15 频点，块指数归 0。
+ *          与滤波器谱相乘时右移 16 位（块指数加 1），保证复数乘法不溢出。
+ *          白化逐点做整数平方根和除法，只有标量实现；变换部分见 `q15_fft_plan_t`。
+ * @param filter 相关滤波器谱，来自 `xcorr_init`
+ * @param signal 原信号，前 min(n, signal.size()) 点被替换为相关结果
+ * @param plan 变换计划
+ * @return 相关结果的块指数，相关值为 raw / 2^15 · 2^exponent
+ */
+inline int xcorr(q15_block_t const &filter, std::vector<q15_t> &signal, q15_fft_plan_t const &plan) {
+    const auto n = plan.size();
+    
+    thread_local q15_block_t spectrum;
+    spectrum.re.assign(n, q15_t{0});
+    spectrum.im.assign(n, q15_t{0});
+    spectrum.exponent = 0;
+    std::copy(signal.begin(), signal.begin() + std::min(signal.size(), n), spectrum.re.begin());
+    plan.forward(spectrum);
+    
+    for (size_t i = 0; i < n; ++i) {
+        auto r = static_cast<int32_t>(spectrum.re[i].raw),
+             j = static_cast<int32_t>(spectrum.im[i].raw);
+        
+        // 白化
+        const auto l = static_cast<int32_t>(std::sqrt(static_cast<double>(int64_t{r} * r + int64_t{j} * j)));
+        if (l == 0) {
+            r = j = 0;
+        } else {
+            r = std::clamp((r << 15) / l, -32768, 32767);
+            j = std::clamp((j << 15) / l, -32768, 32767);
+        }
+        
+        // 乘以滤波器谱
+        const auto fr = static_cast<int32_t>(filter.re[i].raw),
+                   fi = static_cast<int32_t>(filter.im[i].raw);
+        spectrum.re[i] = q15_t::saturate((r * fr - j * fi + (1 << 15)) >> 16);
+        spectrum.im[i] = q15_t::saturate((r * fi + j * fr + (1 << 15)) >> 16);
+    }
+    spectrum.exponent = filter.exponent + 1;
+    plan.inverse(spectrum);
+    
+    std::copy(spectrum.re.begin(), spectrum.re.begin() + std::min(signal.size(), n), signal.begin());
+    return spectrum.exponent;
+}
+
+/// 互相关（动态部分），Q15 块浮点（运行时长度，必须是 2 的整数次幂）
+inline int xcorr(q15_block_t const &filter, std::vector<q15_t> &signal, size_t size) {
+    return xcorr(filter, signal, cached_plan<q15_fft_plan_t>(size));
+}
+
+/// 互相关（动态部分），Q15 块浮点
+template<auto _size>
+int xcorr(q15_block_t const &filter, std::vector<q15_t> &signal) {
+    static_assert(_size > 0 && (_size & (_size - 1)) == 0, "size is not power of 2");
+    
+    return xcorr(filter, signal, cached_plan<q15_fft_plan_t>(_size));
+}
+
+#endif // SIMULATION_FIXED_POINT_H
@@ -0,0 +1,403 @@
+#ifndef SIMULATION_LOCALIZATION_H
+#define SIMULATION_LOCALIZATION_H
+
+#include <span>
+#include <vector>
+#include <cmath>
+#include <utility>
+#include <algorithm>
+
+#include "../signal/split_complex_t.hpp"
+#include "signal_process.h"
+#include "toa_estimator.h"
+#include "thread_pool.h"
+#include "room.h"
+
+/// 定位方式
+enum class localization_mode_t {
+    toa,  // 发射时刻已知（收发同步），到达时刻即飞行时间
+    tdoa, // 发射时刻未知，与位置一起求解
+};
+
+/**
+ * 定位结果
+ * @param valid 是否求得有效位置
+ * @param position 位置
+ * @param offset 发射时刻偏差（秒，仅 TDOA 方式）
+ * @param residual 距离残差的均方根（米）
+ * @param receivers 参与求解的接收器数
+ * @param iterations 高斯-牛顿迭代次数
+ */
+struct position_fix_t {
+    bool    valid;
+    point_t position;
+    float   offset;
+    float   residual;
+    size_t  receivers;
+    size_t  iterations;
+};
+
+/**
+ * TOA/TDOA 位置解算器
+ * @remarks 测量模型为 c·t[i] = |p - s[i]| + b，TOA 方式 b = 0，TDOA 方式 b 为未知的发射时刻偏差乘以声速。
+ *          以第一个有效接收器为参考，将距离方程两两相减化为线性方程，最小二乘解作为初值，
+ *          再以高斯-牛顿法在原非线性模型上迭代。
+ *          线性方程组对初值 `initial` 加了很弱的正则项：接收器共面（如都装在天花板上）时，
+ *          垂直方向不可观测，初值取 `initial` 的高度，迭代收敛到与之同侧的解。
+ *          有效接收器数恰好等于未知数个数时，线性方程少一个，解在一条直线上：
+ *          沿该直线（方程组的零空间）代入参考接收器的距离方程，解一元二次方程得到闭式初值，
+ *          两个根都可行时取位置离 `initial` 较近者（TDOA 方式优先取各距离非负的根）。
+ *          二维方式只解 x、y，z 固定为 `initial.z`，接收器的高度仍参与距离计算。
+ */
+class position_solver_t {
+    constexpr static size_t max_unknowns = 4;
+    
+    std::vector<point_t> _receivers;
+    float                _c;
+    localization_mode_t  _mode;
+    size_t               _dimensions, _iterations;
+    point_t              _initial;
+    
+    /// 列主元高斯消元解 n 元线性方程组，结果写入 b，奇异时返回假
+    static bool gauss(double a[max_unknowns][max_unknowns], double b[max_unknowns], size_t n) {
+        for (size_t k = 0; k < n; ++k) {
+            auto pivot = k;
+            for (auto i = k + 1; i < n; ++i)
+                if (std::abs(a[i][k]) > std::abs(a[pivot][k])) pivot = i;
+            if (std::abs(a[pivot][k]) < 1e-30) return false;
+            std::swap(a[k], a[pivot]);
+            std::swap(b[k], b[pivot]);
+            for (auto i = k + 1; i < n; ++i) {
+                const auto f = a[i][k] / a[k][k];
+                for (auto j = k; j < n; ++j) a[i][j] -= f * a[k][j];
+                b[i] -= f * b[k];
+            }
+        }
+        for (auto k = n; k-- > 0;) {
+            for (auto j = k + 1; j < n; ++j) b[k] -= a[k][j] * b[j];
+            b[k] /= a[k][k];
+        }
+        return true;
+    }
+    
+    /// 至多 3 阶行列式
+    static double determinant(double m[max_unknowns][max_unknowns], size_t n) {
+        switch (n) {
+            case 1:
+                return m[0][0];
+            case 2:
+                return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+            case 3:
+                return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                       - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+                       + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+            default:
+                return 1;
+        }
+    }
+    
+    /// (n-1)×n 矩阵的零空间向量（广义叉积，各分量为去掉对应列的带符号余子式）
+    static void null_vector(double rows[max_unknowns][max_unknowns], size_t n, double v[max_unknowns]) {
+        for (size_t j = 0; j < n; ++j) {
+            double minor[max_unknowns][max_unknowns]{};
+            for (size_t i = 0; i + 1 < n; ++i)
+                for (size_t k = 0, c = 0; k < n; ++k)
+                    if (k != j) minor[i][c++] = rows[i][k];
+            v[j] = (j % 2 ? -1 : 1) * determinant(minor, n - 1);
+        }
+    }
+    
+    static double coordinate(point_t const &p, size_t i) {
+        return i == 0 ? p.x : i == 1 ? p.y : p.z;
+    }
+    
+    [[nodiscard]]
+    size_t unknowns() const {
+        return _dimensions + (_mode == localization_mode_t::tdoa);
+    }
+
+public:
+    /**
+     * 构造解算器
+     * @param receivers 接收器位置
+     * @param c 声速
+     * @param mode 定位方式
+     * @param dimensions 求解维数，2 或 3
+     * @param initial 初值参考点，见类说明
+     * @param iterations 最大迭代次数
+     */
+    explicit position_solver_t(
+        std::vector<point_t> receivers,
+        float c = 340,
+        localization_mode_t mode = localization_mode_t::tdoa,
+        size_t dimensions = 3,
+        point_t initial = {0, 0, 0},
+        size_t iterations = 10
+    ) : _receivers(std::move(receivers)), _c(c), _mode(mode),
+        _dimensions(std::clamp<size_t>(dimensions, 2, 3)), _iterations(iterations), _initial(initial) {}
+    
+    /// 接收器位置
+    [[nodiscard]]
+    std::vector<point_t> const &receivers() const {
+        return _receivers;
+    }
+    
+    /**
+     * 解算位置
+     * @param arrivals 各接收器的到达时刻（秒），NaN 表示该路未检测到，不参与求解；最多使用前 64 路
+     * @return 定位结果，有效接收器数少于未知数个数时无效
+     */
+    [[nodiscard]]
+    position_fix_t solve(std::span<float const> arrivals) const {
+        const auto u     = unknowns(),
+                   count = std::min(arrivals.size(), _receivers.size());
+        const auto tdoa  = _mode == localization_mode_t::tdoa;
+        
+        position_fix_t result{false, _initial, 0, NAN, 0, 0};
+        
+        size_t used[64], n = 0;
+        for (size_t i = 0; i < count && n < 64; ++i)
+            if (!std::isnan(arrivals[i])) used[n++] = i;
+        result.receivers = n;
+        if (n < u) return result;
+        
+        // 线性化初值：2(s[i]-s[0])·p - 2(m[i]-m[0])·b = |s[i]|² - |s[0]|² - m[i]² + m[0]²
+        double a[max_unknowns][max_unknowns]{}, y[max_unknowns]{}, rows[max_unknowns][max_unknowns]{};
+        
+        const auto &s0 = _receivers[used[0]];
+        const auto m0  = static_cast<double>(_c) * arrivals[used[0]];
+        for (size_t k = 1; k < n; ++k) {
+            const auto &si = _receivers[used[k]];
+            const auto mi  = static_cast<double>(_c) * arrivals[used[k]];
+            
+            double row[max_unknowns]{},
+                   rhs = si.dot(si) - s0.dot(s0) - mi * mi + m0 * m0;
+            for (size_t j = 0; j < 3; ++j) {
+                const auto d = 2 * (coordinate(si, j) - coordinate(s0, j));
+                if (j < _dimensions) row[j] = d;
+                else rhs -= d * coordinate(_initial, j);
+            }
+            if (tdoa) row[_dimensions] = -2 * (mi - m0);
+            if (n == u) std::copy(row, row + u, rows[k - 1]);
+            
+            for (size_t i = 0; i < u; ++i) {
+                for (size_t j = 0; j < u; ++j) a[i][j] += row[i] * row[j];
+                y[i] += row[i] * rhs;
+            }
+        }
+        
+        // 向初值的弱正则
+        double theta[max_unknowns]{}, trace = 0;
+        for (size_t j = 0; j < _dimensions; ++j) theta[j] = coordinate(_initial, j);
+        if (tdoa) theta[_dimensions] = m0 - (_initial - s0).norm();
+        for (size_t i = 0; i < u; ++i) trace += a[i][i];
+        const auto lambda = 1e-9 * trace / u;
+        for (size_t i = 0; i < u; ++i) {
+            a[i][i] += lambda;
+            y[i] += lambda * theta[i];
+        }
+        if (!gauss(a, y, u)) return result;
+        std::copy(y, y + u, theta);
+        
+        // 最少接收器：θ(t) = θ + t·v，代入 |p - s[0]|² = (m[0] - b)²（TOA 方式 b = 0），解 t
+        if (n == u) {
+            double v[max_unknowns]{};
+            null_vector(rows, u, v);
+            
+            double q2 = 0, q1 = 0, q0 = 0;
+            for (size_t j = 0; j < 3; ++j) {
+                const auto d = (j < _dimensions ? theta[j] : coordinate(_initial, j)) - coordinate(s0, j),
+                           w = j < _dimensions ? v[j] : 0;
+                q2 += w * w;
+                q1 += 2 * d * w;
+                q0 += d * d;
+            }
+            const auto r = m0 - (tdoa ? theta[_dimensions] : 0),
+                       w = tdoa ? v[_dimensions] : 0;
+            q2 -= w * w;
+            q1 += 2 * r * w;
+            q0 -= r * r;
+            
+            double roots[2], scale = 0;
+            size_t count = 0;
+            for (size_t j = 0; j < u; ++j) scale += v[j] * v[j];
+            if (scale > 0) {
+                const auto discriminant = q1 * q1 - 4 * q2 * q0;
+                if (std::abs(q2) < 1e-12 * scale)
+                    roots[count++] = q1 != 0 ? -q0 / q1 : 0;
+                else if (discriminant < 0) // 测量误差使直线与距离方程不相交，取最接近处
+                    roots[count++] = -q1 / (2 * q2);
+                else {
+                    roots[count++] = (-q1 + std::sqrt(discriminant)) / (2 * q2);
+                    roots[count++] = (-q1 - std::sqrt(discriminant)) / (2 * q2);
+                }
+            }
+            
+            // 候选根的评分：TDOA 方式距离为负者靠后，其次比较到初值参考点的距离
+            auto score = [&](double t) {
+                double distance = 0;
+                for (size_t j = 0; j < _dimensions; ++j) {
+                    const auto d = theta[j] + t * v[j] - coordinate(_initial, j);
+                    distance += d * d;
+                }
+                if (tdoa) {
+                    const auto b = theta[_dimensions] + t * v[_dimensions];
+                    for (size_t k = 0; k < n; ++k)
+                        if (_c * static_cast<double>(arrivals[used[k]]) < b) return std::make_pair(1, distance);
+                }
+                return std::make_pair(0, distance);
+            };
+            if (count) {
+                auto t = roots[0];
+                if (count == 2 && score(roots[1]) < score(roots[0])) t = roots[1];
+                for (size_t j = 0; j < u; ++j) theta[j] += t * v[j];
+            }
+        }
+        
+        // 高斯-牛顿迭代：e[i] = |p - s[i]| + b - m[i]
+        double square    = 0;
+        bool   converged = false;
+        for (size_t step = 0;; ++step) {
+            double jj[max_unknowns][max_unknowns]{}, je[max_unknowns]{};
+            
+            square = 0;
+            for (size_t k = 0; k < n; ++k) {
+                const auto &si = _receivers[used[k]];
+                
+                double delta[3], range = 0;
+                for (size_t j = 0; j < 3; ++j) {
+                    delta[j] = (j < _dimensions ? theta[j] : coordinate(_initial, j)) - coordinate(si, j);
+                    range += delta[j] * delta[j];
+                }
+                range = std::max(std::sqrt(range), 1e-9);
+                
+                double row[max_unknowns]{};
+                for (size_t j = 0; j < _dimensions; ++j) row[j] = delta[j] / range;
+                if (tdoa) row[_dimensions] = 1;
+                
+                const auto e = range + (tdoa ? theta[_dimensions] : 0) - _c * static_cast<double>(arrivals[used[k]]);
+                square += e * e;
+                for (size_t i = 0; i < u; ++i) {
+                    for (size_t j = 0; j < u; ++j) jj[i][j] += row[i] * row[j];
+                    je[i] -= row[i] * e;
+                }
+            }
+            if (converged || step == _iterations) break;
+            
+            trace = 0;
+            for (size_t i = 0; i < u; ++i) trace += jj[i][i];
+            for (size_t i = 0; i < u; ++i) jj[i][i] += 1e-12 * trace;
+            if (!gauss(jj, je, u)) break;
+            
+            double norm = 0;
+            for (size_t i = 0; i < u; ++i) {
+                theta[i] += je[i];
+                norm += je[i] * je[i];
+            }
+            result.iterations = step + 1;
+            converged         = norm < 1e-12; // 步长小于 1 微米
+        }
+        
+        result.valid      = true;
+        result.position.x = static_cast<float>(theta[0]);
+        result.position.y = static_cast<float>(theta[1]);
+        if (_dimensions == 3) result.position.z = static_cast<float>(theta[2]);
+        result.offset   = tdoa ? static_cast<float>(theta[_dimensions] / _c) : 0;
+        result.residual = static_cast<float>(std::sqrt(square / n));
+        return result;
+    }
+};
+
+/**
+ * 多通道定位器
+ * @remarks 对 N 路同步接收通道：在线程池上并行做 PHAT 互相关和到达时刻估计，再逐帧解算位置。
+ *          一批多帧时，（帧，通道）对和各帧解算分别作为并行任务分配，工作区按线程预先申请，
+ *          相关运算使用 span 版本的 `xcorr`，稳定运行时不申请堆内存（结果向量除外）。
+ */
+class multichannel_locator_t {
+    rfft_plan_t const               *_plan;
+    split_complex_t                 _filter;
+    toa_estimator_t                 _estimator;
+    position_solver_t               _solver;
+    thread_pool_t                   &_pool;
+    std::vector<std::vector<float>> _buffers;
+    std::vector<float>              _arrivals;
+    
+    /// 定位 `count` 帧，`input(f, i)` 返回第 f 帧第 i 路信号的指针（缺失时为空）
+    template<class input_t>
+    std::vector<position_fix_t> run(size_t count, input_t const &input, float origin) {
+        const auto channels = this->channels();
+        _arrivals.resize(count * channels);
+        
+        _pool.parallel_for(_arrivals.size(), [&](size_t i, size_t worker) {
+            auto const *signal = input(i / channels, i % channels);
+            if (!signal) {
+                _arrivals[i] = NAN;
+                return;
+            }
+            auto       &buffer = _buffers[worker];
+            const auto n       = std::min(signal->size(), buffer.size());
+            std::copy(signal->begin(), signal->begin() + n, buffer.begin());
+            std::fill(buffer.begin() + n, buffer.end(), 0);
+            
+            xcorr(_filter, std::span<float>(buffer), *_plan);
+            const auto arrival = _estimator.estimate(buffer, origin);
+            _arrivals[i] = arrival.found ? arrival.tof : NAN;
+        });
+        
+        std::vector<position_fix_t> result(count);
+        _pool.parallel_for(count, [&](size_t f, size_t) {
+            result[f] = _solver.solve(std::span<float const>(_arrivals).subspan(f * channels, channels));
+        });
+        return result;
+    }
+
+public:
+    /**
+     * 构造定位器
+     * @param reference 发射信号
+     * @param fft_size 相关变换长度，必须是偶数，每路每帧只处理前 `fft_size` 个点
+     * @param estimator 到达时刻估计器
+     * @param solver 位置解算器，接收器顺序即通道顺序
+     * @param pool 线程池
+     */
+    multichannel_locator_t(
+        std::vector<float> const &reference,
+        size_t fft_size,
+        toa_estimator_t estimator,
+        position_solver_t solver,
+        thread_pool_t &pool
+    ) : _plan(&cached_plan<rfft_plan_t>(fft_size)),
+        _filter(xcorr_init(reference, *_plan)),
+        _estimator(estimator),
+        _solver(std::move(solver)),
+        _pool(pool),
+        _buffers(pool.size(), std::vector<float>(fft_size)) {}
+    
+    /// 通道数
+    [[nodiscard]]
+    size_t channels() const {
+        return _solver.receivers().size();
+    }
+    
+    /**
+     * 定位一批帧
+     * @param frames 帧，`frames[f][i]` 为第 f 帧第 i 路的接收信号
+     * @param origin 发射时刻（帧内点序号，TOA 方式下飞行时间由此起算）
+     * @return 每帧的定位结果
+     */
+    std::vector<position_fix_t> locate(std::vector<std::vector<std::vector<float>>> const &frames, float origin = 0) {
+        return run(frames.size(), [&](size_t f, size_t i) {
+            return i < frames[f].size() ? &frames[f][i] : nullptr;
+        }, origin);
+    }
+    
+    /// 定位一帧
+    position_fix_t locate(std::vector<std::vector<float>> const &channels, float origin = 0) {
+        return run(1, [&](size_t, size_t i) {
+            return i < channels.size() ? &channels[i] : nullptr;
+        }, origin).front();
+    }
+};
+
+#endif // SIMULATION_LOCALIZATION_H
@@ -0,0 +1,123 @@
+#ifndef SIMULATION_MONTE_CARLO_H
+#define SIMULATION_MONTE_CARLO_H
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+#include "signal_process.h"
+#include "multi_path.h"
+#include "noise.h"
+#include "thread_pool.h"
+#include "toa_estimator.h"
+
+/// 蒙特卡洛测距仿真配置
+struct monte_carlo_config_t {
+    std::vector<float>                    reference;      // 发射信号
+    std::vector<db_t>                     snr;            // 信噪比网格（按整帧能量计）
+    std::vector<std::vector<path_info_t>> geometries;     // 多径信道描述
+    size_t                                trials   = 1000;  // 每个组合的试验次数
+    float                                 fs       = 1e6f;  // 采样率
+    float                                 c        = 340;   // 声速
+    size_t                                delay    = 1000;  // 第一径到达时刻（点）
+    size_t                                frame    = 8192;  // 接收帧长，即相关变换长度，必须是偶数
+    size_t                                response = 4096;  // 多径响应长度
+    float                                 outlier  = .01f;  // 离群门限（米）
+    float                                 relative = .3f;   // 首达门限相对最大峰的比例
+    size_t                                lobe     = 64;    // 相关主瓣宽度（点）
+    uint64_t                              seed     = 0;     // 随机种子
+};
+
+/// 一个（信噪比，信道）组合的测距误差统计
+struct range_statistics_t {
+    db_t   snr;
+    size_t geometry;
+    size_t trials;
+    double bias;         // 偏差（米，不含离群点）
+    double rmse;         // 均方根误差（米，不含离群点）
+    double outlier_rate; // 离群率（含未检测到到达的试验）
+};
+
+/**
+ * 蒙特卡洛测距精度仿真
+ * @remarks 对信噪比网格和信道描述的每个组合做 `trials` 次独立试验：
+ *          发射信号经多径信道延迟到达，加噪后与发射信号做 PHAT 互相关，
+ *          由 `toa_estimator_t` 取首达峰的亚采样位置为到达时刻（反射峰更高时也不会误取）。
+ *          无噪声的接收帧和相关滤波器谱每个信道只算一次，所有线程共享；
+ *          每次试验的噪声取自以（种子，试验总序号）确定的 Philox 流，结果与线程数和调度顺序无关。
+ * @param config 配置
+ * @param pool 线程池
+ * @return 每个组合的统计，按信噪比优先的顺序排列
+ */
+inline std::vector<range_statistics_t> monte_carlo(monte_carlo_config_t const &config, thread_pool_t &pool) {
+    if (config.trials == 0) throw std::invalid_argument("monte carlo needs at least one trial");
+    
+    auto const &plan   = cached_plan<rfft_plan_t>(config.frame);
+    const auto filter  = xcorr_init(config.reference, plan);
+    const auto cells   = config.snr.size() * config.geometries.size();
+    
+    const toa_estimator_t estimator(config.fs, config.c, 6, config.relative, config.lobe);
+    
+    // 无噪声接收帧
+    std::vector<std::vector<float>> clean;
+    for (auto const &geometry : config.geometries) {
+        auto response = build_multi_path_response(config.response, config.fs, config.c, geometry);
+        auto received = convolve(config.reference, response, config.frame);
+        
+        std::vector<float> frame(config.frame, 0);
+        for (size_t i = 0; i < received.size() && config.delay + i < frame.size(); ++i)
+            frame[config.delay + i] = received[i];
+        clean.push_back(std::move(frame));
+    }
+    
+    // 每线程一个工作区
+    std::vector<std::vector<float>> buffers(pool.size(), std::vector<float>(config.frame));
+    std::vector<double>             errors(cells * config.trials);
+    
+    pool.parallel_for(errors.size(), [&](size_t i, size_t worker) {
+        const auto cell     = i / config.trials,
+                   geometry = cell % config.geometries.size();
+        const auto snr      = config.snr[cell / config.geometries.size()];
+        
+        philox_t generator(config.seed, i);
+        
+        auto &signal = buffers[worker];
+        std::copy(clean[geometry].begin(), clean[geometry].end(), signal.begin());
+        add_noise(signal, snr, generator);
+        xcorr(filter, signal, plan);
+        
+        // 未检测到到达按离群计
+        const auto arrival = estimator.estimate(signal, static_cast<float>(config.delay));
+        errors[i] = arrival.found ? arrival.distance : std::numeric_limits<double>::infinity();
+    });
+    
+    std::vector<range_statistics_t> result;
+    for (size_t cell = 0; cell < cells; ++cell) {
+        size_t inliers = 0;
+        double sum     = 0, square = 0;
+        for (auto p = errors.begin() + cell * config.trials, end = p + config.trials; p < end; ++p) {
+            if (std::abs(*p) > config.outlier) continue;
+            ++inliers;
+            sum += *p;
+            square += *p * *p;
+        }
+        result.push_back({config.snr[cell / config.geometries.size()],
+                          cell % config.geometries.size(),
+                          config.trials,
+                          inliers ? sum / inliers : NAN,
+                          inliers ? std::sqrt(square / inliers) : NAN,
+                          1 - static_cast<double>(inliers) / config.trials});
+    }
+    return result;
+}
+
+/// 蒙特卡洛测距精度仿真，使用全部硬件线程
+inline std::vector<range_statistics_t> monte_carlo(monte_carlo_config_t const &config) {
+    thread_pool_t pool;
+    return monte_carlo(config, pool);
+}
+
+#endif // SIMULATION_MONTE_CARLO_H
@@ -19,6 +19,28 @@ struct path_info_t {
     int   reflect_times;
 };
 
+/**
+ * 从多径信道描述构造时域响应（运行时长度）
+ * @param length 长度
+ * @param fs 采样率
+ * @param c 声速
+ * @param path_info 信道描述
+ * @return 时域响应（单位脉冲响应信号），落在同一点的路径累加，超出长度的路径被忽略
+ */
+inline std::vector<float> build_multi_path_response(
+    size_t length,
+    float fs, float c,
+    const std::vector<path_info_t> &path_info
+) {
+    auto signal = std::vector<float>(length, 0);
+    if (length) signal[0] = 1;
+    for (auto info:path_info) {
+        auto i = static_cast<size_t>(info.ds / c * fs);
+        if (i < length) signal[i] += info.reflect_times % 2 ? -info.a : info.a;
+    }
+    return signal;
+}
+
 /**
  * 从多径信道描述构造时域响应
  * @tparam _length 长度
@@ -32,12 +54,7 @@ std::vector<float> build_multi_path_response(
     float fs, float c,
     const std::vector<path_info_t> &path_info
 ) {
-    auto signal = std::vector<float>(_length, 0);
-    signal[0] = 1;
-    for (auto info:path_info)
-        signal[static_cast<int>(info.ds / c * fs )]
-            = info.reflect_times % 2 ? -info.a : info.a;
-    return signal;
+    return build_multi_path_response(_length, fs, c, path_info);
 }
 
 #endif //SIMULATION_MULTI_PATH_H
@@ -0,0 +1,189 @@
+#ifndef SIMULATION_MULTIPATH_CHANNEL_H
+#define SIMULATION_MULTIPATH_CHANNEL_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "multi_path.h"
+
+/**
+ * 分数时延、时变多径信道
+ * @remarks 每条声径按分数时延以 4 点拉格朗日插值展开成稀疏抽头，落在同一位置的抽头累加；
+ *          静止声径的抽头预先合并，每个输出点的乘加次数等于非零抽头数。
+ *          按反射次数分组，每次反射经一级一阶低通模拟随频率升高的反射损失。
+ *          声径可带额外路程变化率（米/秒）模拟运动目标，这类声径逐点重算插值系数。
+ *          接口与其他流式处理器一致，可直接放入 `pipeline_t`。
+ */
+class multipath_channel_t {
+    struct tap_t {
+        size_t delay;
+        float  weight;
+    };
+    
+    struct moving_t {
+        float  a;     // 增益（含反射符号）
+        double delay; // 当前时延（点）
+        double rate;  // 每点时延变化量
+    };
+    
+    struct group_t {
+        std::vector<tap_t>    taps;
+        std::vector<moving_t> moving;
+        std::vector<float>    state; // 每次反射一级低通的状态
+    };
+    
+    float                _pole;
+    std::vector<float>   _history;
+    size_t               _mask, _pos, _count, _length;
+    std::vector<group_t> _groups;
+    
+    /// 以 base..base+3 为节点，求分数时延 d 处的拉格朗日插值系数
+    static size_t lagrange(double d, float w[4]) {
+        // 足够接近整数的时延按整数处理，只产生一个抽头
+        if (std::abs(d - std::round(d)) < 1e-4) d = std::round(d);
+        
+        const auto i    = static_cast<size_t>(std::floor(d));
+        const auto base = i ? i - 1 : 0;
+        const auto x    = d - base;
+        for (auto k = 0; k < 4; ++k) {
+            double p = 1;
+            for (auto j = 0; j < 4; ++j)
+                if (j != k) p *= (x - j) / (k - j);
+            w[k] = static_cast<float>(p);
+        }
+        return base;
+    }
+    
+    [[nodiscard]]
+    float at(size_t delay) const {
+        return _history[(_pos - delay) & _mask];
+    }
+
+public:
+    /**
+     * 构造信道
+     * @param fs 采样率
+     * @param c 声速
+     * @param path_info 信道描述（不含直达径）
+     * @param length 最大时延（点），超出的声径被忽略
+     * @param rates 各声径额外路程的变化率（米/秒），为空或不足时视为静止
+     * @param pole 每次反射的一阶低通极点，0 表示与频率无关的反射
+     * @param direct 是否包含增益为 1 的直达径
+     */
+    multipath_channel_t(
+        float fs, float c,
+        std::vector<path_info_t> const &path_info,
+        size_t length,
+        std::vector<float> const &rates = {},
+        float pole = 0,
+        bool direct = true
+    ) : _pole(pole), _pos(0), _count(0), _length(length) {
+        size_t capacity = 1;
+        while (capacity < length + 4) capacity <<= 1u;
+        _history.assign(capacity, 0);
+        _mask = capacity - 1;
+        
+        auto group = [this](int reflect_times) -> group_t & {
+            const auto r = static_cast<size_t>(std::max(reflect_times, 0));
+            if (_groups.size() <= r) _groups.resize(r + 1);
+            _groups[r].state.assign(r, 0);
+            return _groups[r];
+        };
+        
+        if (direct) group(0).taps.push_back({0, 1});
+        for (size_t i = 0; i < path_info.size(); ++i) {
+            auto const &info  = path_info[i];
+            const auto a     = info.reflect_times % 2 ? -info.a : info.a;
+            const auto delay = static_cast<double>(info.ds) / c * fs;
+            const auto rate  = i < rates.size() ? static_cast<double>(rates[i]) / c : 0;
+            auto       &g    = group(info.reflect_times);
+            
+            if (rate != 0) {
+                g.moving.push_back({a, delay, rate});
+                continue;
+            }
+            if (delay < 0 || delay + 3 >= length) continue;
+            
+            float      w[4];
+            const auto base = lagrange(delay, w);
+            for (auto k = 0; k < 4; ++k) {
+                if (std::abs(w[k]) < 1e-7f) continue;
+                auto p = std::find_if(g.taps.begin(), g.taps.end(),
+                                      [d = base + k](tap_t const &t) { return t.delay == d; });
+                if (p == g.taps.end())
+                    g.taps.push_back({base + k, a * w[k]});
+                else
+                    p->weight += a * w[k];
+            }
+        }
+        for (auto &g : _groups)
+            std::sort(g.taps.begin(), g.taps.end(), [](tap_t const &a, tap_t const &b) { return a.delay < b.delay; });
+    }
+    
+    /// 清除历史输入，回到初始状态（运动声径的时延不复位）
+    void reset() {
+        std::fill(_history.begin(), _history.end(), 0);
+        for (auto &g : _groups) std::fill(g.state.begin(), g.state.end(), 0);
+        _pos   = 0;
+        _count = 0;
+    }
+    
+    /// 静止声径合并后的抽头数
+    [[nodiscard]]
+    size_t taps() const {
+        size_t n = 0;
+        for (auto const &g : _groups) n += g.taps.size();
+        return n;
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param output 输出追加到此处（与输入等长）
+     */
+    void process(float const *input, size_t length, std::vector<float> &output) {
+        for (auto end = input + length; input < end; ++input) {
+            _pos = (_pos + 1) & _mask;
+            _history[_pos] = *input;
+            ++_count;
+            
+            float y = 0;
+            for (auto &g : _groups) {
+                float sum = 0;
+                for (auto const &tap : g.taps) sum += tap.weight * at(tap.delay);
+                for (auto &path : g.moving) {
+                    if (path.delay >= 0 && path.delay + 3 < _length) {
+                        float      w[4];
+                        const auto base = lagrange(path.delay, w);
+                        for (auto k = 0; k < 4; ++k) sum += path.a * w[k] * at(base + k);
+                    }
+                    path.delay += path.rate;
+                }
+                for (auto &state : g.state) sum = state = (1 - _pole) * sum + _pole * state;
+                y += sum;
+            }
+            output.push_back(y);
+        }
+    }
+    
+    /// 送入一段输入，返回输出
+    std::vector<float> process(std::vector<float> const &input) {
+        std::vector<float> output;
+        process(input.data(), input.size(), output);
+        return output;
+    }
+    
+    /**
+     * 以 0 补齐，输出最大时延范围内的拖尾
+     * @param output 输出追加到此处
+     */
+    void flush(std::vector<float> &output) {
+        const float zero = 0;
+        for (auto i = _length; i; --i) process(&zero, 1, output);
+        reset();
+    }
+};
+
+#endif // SIMULATION_MULTIPATH_CHANNEL_H
@@ -11,13 +11,14 @@
 #include <random>
 
 #include "../signal/complex_t.hpp"
+#include "random.h"
 
 struct db_t {
     float value;
     
     [[nodiscard]]
     inline float to_float() const {
-        return std::powf(10, value / 10);
+        return std::pow(10.0f, value / 10);
     }
     
     [[nodiscard]]
@@ -48,23 +49,37 @@ float energy(std::vector<sample_t> const &signal) {
     ) / signal.size();
 }
 
-/// 为信号加噪
+/// 为信号加噪，使用给定的随机数发生器，结果可复现
+/// \tparam generator_t 随机数发生器类型，如 `xoshiro256_t`、`philox_t`
+/// \param signal 信号
+/// \param snr 信噪比
+/// \param generator 随机数发生器
+template<class generator_t>
+void add_noise(std::vector<float> &signal, float snr, generator_t &generator) {
+    float sigma = std::sqrt(energy(signal) / snr);
+    if (sigma == 0) return;
+    
+    add_gaussian(signal.data(), signal.size(), sigma, generator);
+}
+
+/// 为信号加噪，使用给定的随机数发生器，结果可复现
+template<class generator_t>
+void add_noise(std::vector<float> &signal, db_t snr, generator_t &generator) {
+    add_noise(signal, snr.to_float(), generator);
+}
+
+/// 为信号加噪（每次以随机设备取种子，结果不可复现）
 /// \tparam snr_t 信噪比类型
 /// \param signal 信号
 /// \param snr 信噪比
 template<class snr_t>
 void add_noise(std::vector<float> &signal, snr_t snr) {
-    float sigma = std::sqrtf(energy(signal) / snr);
-    if (sigma == 0) return;
-    
-    std::random_device         rd{};
-    std::mt19937               gen{rd()};
-    std::normal_distribution<> d{0, sigma};
-    
-    for (auto &x:signal) x += d(gen);
+    std::random_device rd{};
+    xoshiro256_t       gen{uint64_t{rd()} << 32u | rd()};
+    add_noise(signal, static_cast<float>(snr), gen);
 }
 
-void add_noise(std::vector<float> &signal, db_t snr) {
+inline void add_noise(std::vector<float> &signal, db_t snr) {
     add_noise(signal, snr.to_float());
 }
 
@@ -0,0 +1,237 @@
+#ifndef SIMULATION_NOISE_MODEL_H
+#define SIMULATION_NOISE_MODEL_H
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "noise.h"
+#include "random.h"
+#include "overlap_save.h"
+#include "resampler.h"
+
+/// 高斯白噪声模型（单位方差）
+struct white_noise_t {
+    template<class generator_t>
+    void generate(float *data, size_t length, generator_t &generator) {
+        fill_gaussian(data, length, 1, generator);
+    }
+};
+
+/**
+ * 粉红噪声模型（单位方差）
+ * @remarks 白噪声经 Paul Kellet 的 7 极点 IIR 滤波器整形，在 fs/4800 到 fs/2 之间功率谱按 1/f 下降，
+ *          方差由冲激响应能量归一化。滤波器状态跨块保持，输出连续。
+ */
+class pink_noise_t {
+    float _b[7]{}, _gain;
+    
+    float filter(float white) {
+        _b[0] = .99886f * _b[0] + white * .0555179f;
+        _b[1] = .99332f * _b[1] + white * .0750759f;
+        _b[2] = .96900f * _b[2] + white * .1538520f;
+        _b[3] = .86650f * _b[3] + white * .3104856f;
+        _b[4] = .55000f * _b[4] + white * .5329522f;
+        _b[5] = -.7616f * _b[5] - white * .0168980f;
+        
+        const auto pink = _b[0] + _b[1] + _b[2] + _b[3] + _b[4] + _b[5] + _b[6] + white * .5362f;
+        _b[6] = white * .115926f;
+        return pink;
+    }
+
+public:
+    pink_noise_t() : _gain(1) {
+        double sum = 0;
+        for (auto i = 0; i < 1 << 16; ++i) {
+            const auto h = filter(i == 0);
+            sum += h * h;
+        }
+        std::fill(_b, _b + 7, 0);
+        _gain = static_cast<float>(1 / std::sqrt(sum));
+    }
+    
+    template<class generator_t>
+    void generate(float *data, size_t length, generator_t &generator) {
+        fill_gaussian(data, length, 1, generator);
+        for (auto end = data + length; data < end; ++data) *data = _gain * filter(*data);
+    }
+};
+
+/**
+ * 带限噪声模型（单位方差）
+ * @remarks 白噪声经凯泽窗 FIR 带通滤波器（重叠保留法）整形，滤波器状态跨块保持，输出连续。
+ *          滤波器从零状态启动，前 `taps - 1` 个输出只覆盖部分抽头、方差偏小，这段启动过程被丢弃，
+ *          第一个输出点即为稳态。
+ */
+class band_noise_t {
+    overlap_save_t     _filter;
+    std::vector<float> _white, _pending;
+    size_t             _read, _skip; // _skip: 尚未丢弃的启动过程点数
+    
+    static std::vector<float> design(float fs, float f0, float f1, size_t taps) {
+        taps |= 1u;
+        auto h = resampler::bandpass(taps, (taps - 1) / 2.0, f0 / fs, f1 / fs);
+        
+        double sum = 0;
+        for (auto x : h) sum += x * x;
+        for (auto &x : h) x /= static_cast<float>(std::sqrt(sum));
+        return h;
+    }
+
+public:
+    /**
+     * 构造带限噪声模型
+     * @param fs 采样率
+     * @param f0 下限频率（为 0 时为低通）
+     * @param f1 上限频率
+     * @param taps 滤波器长度
+     */
+    band_noise_t(float fs, float f0, float f1, size_t taps = 255)
+        : _filter(design(fs, f0, f1, taps)), _white(_filter.block_size()), _read(0), _skip(_filter.taps() - 1) {}
+    
+    template<class generator_t>
+    void generate(float *data, size_t length, generator_t &generator) {
+        while (length) {
+            if (_read == _pending.size()) {
+                _pending.clear();
+                _read = 0;
+                fill_gaussian(_white.data(), _white.size(), 1, generator);
+                _filter.process(_white.data(), _white.size(), _pending);
+                _read = std::min(_skip, _pending.size());
+                _skip -= _read;
+                continue;
+            }
+            const auto n = std::min(length, _pending.size() - _read);
+            std::copy(_pending.begin() + _read, _pending.begin() + _read + n, data);
+            _read += n;
+            data += n;
+            length -= n;
+        }
+    }
+};
+
+/**
+ * Middleton A 类脉冲噪声模型（单位方差）
+ * @remarks 每个采样点的脉冲数 m 服从参数为 A 的泊松分布，给定 m 时为方差 (m/A + Γ)/(1 + Γ) 的高斯分布。
+ *          A 越小脉冲越稀疏、越强；Γ 为高斯背景与脉冲分量的功率比。
+ */
+class class_a_noise_t {
+    float _a, _gamma;
+
+public:
+    /**
+     * 构造 A 类噪声模型
+     * @param a 脉冲指数 A，必须为正
+     * @param gamma 高斯与脉冲功率比 Γ，不能为负
+     */
+    class_a_noise_t(float a, float gamma) : _a(a), _gamma(gamma) {
+        if (!(a > 0)) throw std::invalid_argument("class A impulsive index must be positive");
+        if (!(gamma >= 0)) throw std::invalid_argument("class A power ratio must not be negative");
+    }
+    
+    template<class generator_t>
+    void generate(float *data, size_t length, generator_t &generator) {
+        constexpr auto scale = 1.0f / (1u << 24u);
+        
+        fill_gaussian(data, length, 1, generator);
+        const auto limit = std::exp(-_a);
+        for (auto end = data + length; data < end; ++data) {
+            // 乘积法抽取泊松数
+            size_t m = 0;
+            for (auto p = 1.0f;; ++m) {
+                p *= static_cast<float>((static_cast<uint32_t>(generator()) >> 8u) + 1) * scale;
+                if (p <= limit) break;
+            }
+            *data *= std::sqrt((m / _a + _gamma) / (1 + _gamma));
+        }
+    }
+};
+
+/**
+ * 滑动能量估计
+ * @remarks 以时间常数 `window` 个点的指数平均跟踪 x² 的均值，第一块以块内均值初始化。
+ *          可用于在连续数据上按块设置信噪比，而不需要预先得到整段信号。
+ */
+class energy_estimator_t {
+    float _alpha, _value;
+    bool  _primed;
+
+public:
+    explicit energy_estimator_t(size_t window = 4096)
+        : _alpha(1.0f / std::max<size_t>(window, 1)), _value(0), _primed(false) {}
+    
+    /// 送入一块信号
+    void update(float const *data, size_t length) {
+        if (length == 0) return;
+        if (!_primed) {
+            float sum = 0;
+            for (size_t i = 0; i < length; ++i) sum += data[i] * data[i];
+            _value  = sum / length;
+            _primed = true;
+            return;
+        }
+        for (auto end = data + length; data < end; ++data)
+            _value += _alpha * (*data * *data - _value);
+    }
+    
+    /// 当前能量估计
+    [[nodiscard]]
+    float value() const {
+        return _value;
+    }
+    
+    void reset() {
+        _value  = 0;
+        _primed = false;
+    }
+};
+
+/**
+ * 按整段信号能量加指定模型的噪声
+ * @param signal 信号
+ * @param snr 信噪比
+ * @param model 噪声模型，如 `pink_noise_t`、`band_noise_t`、`class_a_noise_t`
+ * @param generator 随机数发生器
+ */
+template<class model_t, class generator_t>
+void add_noise(std::vector<float> &signal, db_t snr, model_t &model, generator_t &generator) {
+    const auto sigma = std::sqrt(energy(signal) / snr.to_float());
+    if (sigma == 0) return;
+    
+    float buffer[256];
+    for (size_t i = 0; i < signal.size(); i += 256) {
+        const auto n = std::min<size_t>(256, signal.size() - i);
+        model.generate(buffer, n, generator);
+        for (size_t j = 0; j < n; ++j) signal[i + j] += sigma * buffer[j];
+    }
+}
+
+/**
+ * 按滑动能量估计为一块信号加噪，用于连续数据
+ * @param data 信号块
+ * @param length 块长
+ * @param snr 信噪比
+ * @param estimator 能量估计器，先以本块更新
+ * @param model 噪声模型
+ * @param generator 随机数发生器
+ */
+template<class model_t, class generator_t>
+void add_noise(
+    float *data, size_t length, db_t snr,
+    energy_estimator_t &estimator, model_t &model, generator_t &generator
+) {
+    estimator.update(data, length);
+    const auto sigma = std::sqrt(estimator.value() / snr.to_float());
+    if (sigma == 0) return;
+    
+    float buffer[256];
+    for (size_t i = 0; i < length; i += 256) {
+        const auto n = std::min<size_t>(256, length - i);
+        model.generate(buffer, n, generator);
+        for (size_t j = 0; j < n; ++j) data[i + j] += sigma * buffer[j];
+    }
+}
+
+#endif // SIMULATION_NOISE_MODEL_H
@@ -0,0 +1,130 @@
+#ifndef SIMULATION_OVERLAP_SAVE_H
+#define SIMULATION_OVERLAP_SAVE_H
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../signal/split_complex_t.hpp"
+#include "fft.h"
+
+/**
+ * 重叠保留法流式卷积器
+ * @remarks 保存滤波器频谱和上一帧尾部的 L-1 个输入点，输入可按任意长度分块送入。
+ *          每凑满 B = N - L + 1 个新输入点做一次 N 点变换，输出 B 个点，
+ *          因此输出相对输入的附加延迟不超过 B - 1 个点。
+ */
+class overlap_save_t {
+    size_t             _taps, _block;
+    rfft_plan_t const  *_plan;
+    split_complex_t    _filter, _spectrum;
+    std::vector<float> _frame;
+    size_t             _fill;
+    
+    /// 变换当前帧并输出 B 个点
+    void run(std::vector<float> &output) {
+        const auto half = _plan->size() / 2;
+        
+        for (size_t i = 0; i < half; ++i) {
+            _spectrum.re[i] = _frame[2 * i];
+            _spectrum.im[i] = _frame[2 * i + 1];
+        }
+        _plan->forward(_spectrum.re.data(), _spectrum.im.data());
+        _spectrum *= _filter;
+        _plan->inverse(_spectrum.re.data(), _spectrum.im.data());
+        
+        for (auto i = _taps - 1; i < _frame.size(); ++i)
+            output.push_back(i & 1u ? _spectrum.im[i / 2] : _spectrum.re[i / 2]);
+        
+        // 保留最后 L-1 个输入点
+        std::copy(_frame.end() - (_taps - 1), _frame.end(), _frame.begin());
+        _fill = _taps - 1;
+    }
+
+public:
+    /**
+     * 构造卷积器
+     * @param filter 滤波器冲激响应（L 点）
+     * @param fft_size 变换长度，必须是偶数（由 `rfft_plan_t` 检查）且不小于 L，否则抛出 `std::invalid_argument`；
+     *                 为 0 时取不小于 2L 的 2 的整数次幂
+     */
+    explicit overlap_save_t(std::vector<float> const &filter, size_t fft_size = 0)
+        : _taps(std::max<size_t>(filter.size(), 1)), _fill(0) {
+        if (fft_size == 0) {
+            fft_size = 2;
+            while (fft_size < 2 * _taps) fft_size <<= 1u;
+        }
+        if (fft_size < _taps) throw std::invalid_argument("fft size must not be less than filter length");
+        _block = fft_size - _taps + 1;
+        _plan  = &cached_plan<rfft_plan_t>(fft_size);
+        
+        _spectrum = split_complex_t(fft_size / 2 + 1);
+        _filter   = split_complex_t(fft_size / 2 + 1);
+        for (size_t i = 0; i < filter.size(); ++i)
+            (i & 1u ? _filter.im : _filter.re)[i / 2] = filter[i];
+        _plan->forward(_filter.re.data(), _filter.im.data());
+        
+        _frame.assign(fft_size, 0);
+        reset();
+    }
+    
+    /// 清除历史输入，回到初始状态
+    void reset() {
+        std::fill(_frame.begin(), _frame.end(), 0);
+        _fill = _taps - 1;
+    }
+    
+    /// 滤波器长度
+    [[nodiscard]]
+    size_t taps() const {
+        return _taps;
+    }
+    
+    /// 每次变换产生的输出点数
+    [[nodiscard]]
+    size_t block_size() const {
+        return _block;
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param output 产生的输出追加到此处（每次追加 `block_size()` 的整数倍个点）
+     */
+    void process(float const *input, size_t length, std::vector<float> &output) {
+        while (length) {
+            const auto n = std::min(length, _frame.size() - _fill);
+            std::copy(input, input + n, _frame.begin() + _fill);
+            _fill += n;
+            input += n;
+            length -= n;
+            if (_fill == _frame.size()) run(output);
+        }
+    }
+    
+    /// 送入一段输入，返回这次产生的输出
+    std::vector<float> process(std::vector<float> const &input) {
+        std::vector<float> output;
+        process(input.data(), input.size(), output);
+        return output;
+    }
+    
+    /**
+     * 以 0 补齐并输出剩余部分，包括尚未输出的输入点和滤波器的 L-1 点拖尾
+     * @param output 输出追加到此处
+     */
+    void flush(std::vector<float> &output) {
+        // 尚未输出的输入点数加上拖尾长度
+        const auto size   = output.size(),
+                   remain = _fill;
+        while (output.size() - size < remain) {
+            std::fill(_frame.begin() + _fill, _frame.end(), 0);
+            run(output);
+        }
+        output.resize(size + remain);
+        reset();
+    }
+};
+
+#endif // SIMULATION_OVERLAP_SAVE_H
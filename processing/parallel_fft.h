@@ -0,0 +1,215 @@
+#ifndef SIMULATION_PARALLEL_FFT_H
+#define SIMULATION_PARALLEL_FFT_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../signal/complex_t.hpp"
+#include "fft.h"
+#include "arena.h"
+#include "thread_pool.h"
+
+/**
+ * 并行四步法 FFT 变换计划
+ * @remarks 把 n = n1·n2 点变换看作 n2 行 n1 列的矩阵 x[n2][n1]：
+ *          1. 转置为 n1 行，每行做 n2 点变换并乘以旋转因子 ω<n, n1·k2>；
+ *          2. 再转置为 n2 行，每行做 n1 点变换；
+ *          3. 最后转置得到 X[k1·n2 + k2]。
+ *          每步的各行互不相关，在线程池上并行；行变换使用共享的（只读的）子计划，
+ *          子变换长度约为 √n，每行的数据能放进缓存。转置按 32×32 分块进行。
+ *          工作区取自调用线程的临时内存区。n 为素数（无法分解）时退化为单线程变换。
+ */
+class four_step_fft_t {
+    constexpr static size_t tile = 32;
+    
+    size_t                 _length, _rows, _columns; // n = _rows(n1)·_columns(n2)
+    fft_plan_t const       *_row_plan, *_column_plan;
+    std::vector<complex_t> _twiddles;                // ω<n,k>，0 <= k < n
+    
+    /// 分块转置：src 为 rows 行 columns 列，dst 为 columns 行 rows 列
+    static void transpose(
+        complex_t const *src, complex_t *dst,
+        size_t rows, size_t columns,
+        thread_pool_t &pool
+    ) {
+        const auto tiles = (rows + tile - 1) / tile;
+        pool.parallel_for(tiles, [=](size_t t, size_t) {
+            const auto r0 = t * tile, r1 = std::min(rows, r0 + tile);
+            for (size_t c0 = 0; c0 < columns; c0 += tile) {
+                const auto c1 = std::min(columns, c0 + tile);
+                for (auto r = r0; r < r1; ++r)
+                    for (auto c = c0; c < c1; ++c)
+                        dst[c * rows + r] = src[r * columns + c];
+            }
+        });
+    }
+    
+    void transform(complex_t *memory, thread_pool_t &pool, bool inverse) const {
+        if (_rows == 1) {
+            inverse ? _column_plan->inverse(memory) : _column_plan->forward(memory);
+            return;
+        }
+        
+        arena_scope_t scope;
+        auto          buffer = scope.allocate<complex_t>(_length).data();
+        
+        // 反变换 = 共轭 -> 正变换 -> 共轭，1/n 归一化在最后一步完成
+        if (inverse)
+            pool.parallel_for(_columns, [=, this](size_t i, size_t) {
+                for (auto p = memory + i * _rows, end = p + _rows; p < end; ++p) p->im = -p->im;
+            });
+        
+        // x[n2][n1] -> y[n1][n2]，每行 n2 点变换，乘旋转因子
+        transpose(memory, buffer, _columns, _rows, pool);
+        pool.parallel_for(_rows, [=, this](size_t n1, size_t) {
+            auto row = buffer + n1 * _columns;
+            _column_plan->forward(row);
+            for (size_t k2 = 1; k2 < _columns; ++k2)
+                row[k2] *= _twiddles[n1 * k2];
+        });
+        
+        // y[n1][k2] -> z[k2][n1]，每行 n1 点变换
+        transpose(buffer, memory, _rows, _columns, pool);
+        pool.parallel_for(_columns, [=, this](size_t k2, size_t) {
+            _row_plan->forward(memory + k2 * _rows);
+        });
+        
+        // z[k2][k1] -> X[k1][k2]
+        transpose(memory, buffer, _columns, _rows, pool);
+        const auto k = inverse ? 1.0f / _length : 1.0f;
+        pool.parallel_for(_rows, [=, this](size_t i, size_t) {
+            auto dst = memory + i * _columns;
+            auto src = buffer + i * _columns;
+            if (inverse)
+                for (size_t j = 0; j < _columns; ++j) dst[j] = src[j].conjugate() * k;
+            else
+                std::copy(src, src + _columns, dst);
+        });
+    }
+
+public:
+    /// 构造 n 点变换计划，取不大于 √n 的最大因数为 n1
+    explicit four_step_fft_t(size_t n) : _length(n), _rows(1) {
+        for (auto i = static_cast<size_t>(std::sqrt(static_cast<double>(n))); i > 1; --i)
+            if (n % i == 0) {
+                _rows = i;
+                break;
+            }
+        _columns     = n / _rows;
+        _row_plan    = &cached_plan<fft_plan_t>(_rows);
+        _column_plan = &cached_plan<fft_plan_t>(_columns);
+        
+        if (_rows > 1) {
+            _twiddles.resize(n);
+            for (size_t k = 0; k < n; ++k) {
+                auto theta = 2 * M_PI * k / n;
+                _twiddles[k] = {static_cast<float>(std::cos(theta)),
+                                static_cast<float>(std::sin(theta))};
+            }
+        }
+    }
+    
+    four_step_fft_t(four_step_fft_t const &) = delete;
+    
+    four_step_fft_t &operator=(four_step_fft_t const &) = delete;
+    
+    /// 变换长度
+    [[nodiscard]]
+    size_t size() const {
+        return _length;
+    }
+    
+    /// 原地正变换
+    void forward(complex_t *memory, thread_pool_t &pool) const {
+        transform(memory, pool, false);
+    }
+    
+    /// 原地反变换（含 1/n 归一化）
+    void inverse(complex_t *memory, thread_pool_t &pool) const {
+        transform(memory, pool, true);
+    }
+};
+
+/// 快速傅里叶正变换，单个大变换在线程池上并行
+inline void fft(complex_t *memory, size_t n, thread_pool_t &pool) {
+    cached_plan<four_step_fft_t>(n).forward(memory, pool);
+}
+
+/// 快速傅里叶反变换，单个大变换在线程池上并行
+inline void ifft(complex_t *memory, size_t n, thread_pool_t &pool) {
+    cached_plan<four_step_fft_t>(n).inverse(memory, pool);
+}
+
+/**
+ * 批量快速傅里叶变换
+ * @remarks 各帧互不相关，按连续的帧段分配给工作线程，同一线程处理的帧在内存中相邻。
+ *          所有线程共享同一份只读计划，计划内的工作区是线程局部的。
+ * @param frames 连续存放的 `count` 帧，每帧 `n` 点，原地变换
+ * @param n 每帧长度
+ * @param count 帧数
+ * @param pool 线程池
+ * @param inverse 是否为反变换（含 1/n 归一化）
+ */
+inline void fft_batch(complex_t *frames, size_t n, size_t count, thread_pool_t &pool, bool inverse = false) {
+    auto const &plan = cached_plan<fft_plan_t>(n);
+    pool.parallel_for(count, [&](size_t i, size_t) {
+        inverse ? plan.inverse(frames + i * n) : plan.forward(frames + i * n);
+    });
+}
+
+/// 批量快速傅里叶变换，每帧一个向量，长度须相同
+inline void fft_batch(std::vector<std::vector<complex_t>> &frames, thread_pool_t &pool, bool inverse = false) {
+    if (frames.empty()) return;
+    auto const &plan = cached_plan<fft_plan_t>(frames.front().size());
+    pool.parallel_for(frames.size(), [&](size_t i, size_t) {
+        inverse ? plan.inverse(frames[i].data()) : plan.forward(frames[i].data());
+    });
+}
+
+/**
+ * 批量实信号快速傅里叶正变换
+ * @param signals 原信号（不足变换长度补 0，超出部分忽略）
+ * @param n 变换长度，必须是偶数
+ * @param pool 线程池
+ * @return 每帧非负频率部分的频谱，共 `n / 2 + 1` 点
+ */
+inline std::vector<std::vector<complex_t>> rfft_batch(
+    std::vector<std::vector<float>> const &signals,
+    size_t n,
+    thread_pool_t &pool
+) {
+    auto const                          &plan = cached_plan<rfft_plan_t>(n);
+    std::vector<std::vector<complex_t>> spectra(signals.size(), std::vector<complex_t>(n / 2 + 1));
+    pool.parallel_for(signals.size(), [&](size_t i, size_t) {
+        auto const &signal = signals[i];
+        std::copy(signal.begin(), signal.begin() + std::min(signal.size(), n),
+                  reinterpret_cast<float *>(spectra[i].data()));
+        plan.forward(spectra[i].data());
+    });
+    return spectra;
+}
+
+/**
+ * 批量实信号快速傅里叶反变换
+ * @param spectra 非负频率部分的频谱，共 `n / 2 + 1` 点，将被用作工作区
+ * @param n 变换长度，必须是偶数
+ * @param pool 线程池
+ * @return 每帧的实信号，`n` 点
+ */
+inline std::vector<std::vector<float>> irfft_batch(
+    std::vector<std::vector<complex_t>> &spectra,
+    size_t n,
+    thread_pool_t &pool
+) {
+    auto const                      &plan = cached_plan<rfft_plan_t>(n);
+    std::vector<std::vector<float>> signals(spectra.size(), std::vector<float>(n));
+    pool.parallel_for(spectra.size(), [&](size_t i, size_t) {
+        plan.inverse(spectra[i].data());
+        auto p = reinterpret_cast<float const *>(spectra[i].data());
+        std::copy(p, p + n, signals[i].begin());
+    });
+    return signals;
+}
+
+#endif // SIMULATION_PARALLEL_FFT_H
@@ -0,0 +1,151 @@
+#ifndef SIMULATION_PARTITIONED_CONVOLVER_H
+#define SIMULATION_PARTITIONED_CONVOLVER_H
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../signal/split_complex_t.hpp"
+#include "fft.h"
+
+/**
+ * 均匀分段流式卷积器
+ * @remarks 将 L 点冲激响应切成 P = ⌈L/B⌉ 段，每段做 2B 点变换保存频谱；
+ *          输入频谱保存在长度为 P 的频域延迟线中，每块输出为各段频谱乘积之和的反变换。
+ *          变换长度只取决于块长 B 而与 L 无关，输出相对输入的延迟为 B 个点。
+ */
+class partitioned_convolver_t {
+    size_t                       _taps, _block;
+    rfft_plan_t const            *_plan;
+    std::vector<split_complex_t> _filter, _delay;
+    split_complex_t              _sum;
+    std::vector<float>           _frame;
+    size_t                       _fill, _head;
+    
+    /// 变换当前帧并输出 B 个点
+    void run(std::vector<float> &output) {
+        auto &spectrum = _delay[_head];
+        for (size_t i = 0; i < _block; ++i) {
+            spectrum.re[i] = _frame[2 * i];
+            spectrum.im[i] = _frame[2 * i + 1];
+        }
+        _plan->forward(spectrum.re.data(), spectrum.im.data());
+        
+        // 第 p 段滤波器与 p 块之前的输入频谱相乘
+        std::fill(_sum.re.begin(), _sum.re.end(), 0);
+        std::fill(_sum.im.begin(), _sum.im.end(), 0);
+        for (size_t p = 0, i = _head; p < _filter.size(); ++p, i = i ? i - 1 : _delay.size() - 1)
+            _sum.multiply_add(_delay[i], _filter[p]);
+        _plan->inverse(_sum.re.data(), _sum.im.data());
+        
+        for (auto i = _block; i < _frame.size(); ++i)
+            output.push_back(i & 1u ? _sum.im[i / 2] : _sum.re[i / 2]);
+        
+        std::copy(_frame.begin() + _block, _frame.end(), _frame.begin());
+        _fill = _block;
+        _head = (_head + 1) % _delay.size();
+    }
+    
+    /// 检查参数，通过时返回块长
+    static size_t checked_block(std::vector<float> const &filter, size_t block) {
+        if (filter.empty()) throw std::invalid_argument("impulse response must not be empty");
+        if (block == 0) throw std::invalid_argument("block size must be positive");
+        return block;
+    }
+
+public:
+    /**
+     * 构造卷积器
+     * @param filter 滤波器冲激响应（L 点），不能为空
+     * @param block 块长 B，必须为正；否则抛出 `std::invalid_argument`
+     */
+    partitioned_convolver_t(std::vector<float> const &filter, size_t block)
+        : _taps(filter.size()),
+          _block(checked_block(filter, block)),
+          _plan(&cached_plan<rfft_plan_t>(2 * block)),
+          _sum(block + 1),
+          _frame(2 * block, 0),
+          _fill(block),
+          _head(0) {
+        const auto count = (_taps + _block - 1) / _block;
+        _filter.assign(count, split_complex_t(_block + 1));
+        _delay.assign(count, split_complex_t(_block + 1));
+        for (size_t i = 0; i < filter.size(); ++i) {
+            auto &part = _filter[i / _block];
+            auto j     = i % _block;
+            (j & 1u ? part.im : part.re)[j / 2] = filter[i];
+        }
+        for (auto &part : _filter)
+            _plan->forward(part.re.data(), part.im.data());
+    }
+    
+    /// 清除历史输入，回到初始状态
+    void reset() {
+        std::fill(_frame.begin(), _frame.end(), 0);
+        for (auto &spectrum : _delay) {
+            std::fill(spectrum.re.begin(), spectrum.re.end(), 0);
+            std::fill(spectrum.im.begin(), spectrum.im.end(), 0);
+        }
+        _fill = _block;
+        _head = 0;
+    }
+    
+    /// 滤波器长度
+    [[nodiscard]]
+    size_t taps() const {
+        return _taps;
+    }
+    
+    /// 块长，即每次变换产生的输出点数
+    [[nodiscard]]
+    size_t block_size() const {
+        return _block;
+    }
+    
+    /// 分段数
+    [[nodiscard]]
+    size_t partitions() const {
+        return _filter.size();
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param output 产生的输出追加到此处（每次追加 `block_size()` 的整数倍个点）
+     */
+    void process(float const *input, size_t length, std::vector<float> &output) {
+        while (length) {
+            const auto n = std::min(length, _frame.size() - _fill);
+            std::copy(input, input + n, _frame.begin() + _fill);
+            _fill += n;
+            input += n;
+            length -= n;
+            if (_fill == _frame.size()) run(output);
+        }
+    }
+    
+    /// 送入一段输入，返回这次产生的输出
+    std::vector<float> process(std::vector<float> const &input) {
+        std::vector<float> output;
+        process(input.data(), input.size(), output);
+        return output;
+    }
+    
+    /**
+     * 以 0 补齐并输出剩余部分，包括尚未输出的输入点和滤波器的 L-1 点拖尾
+     * @param output 输出追加到此处
+     */
+    void flush(std::vector<float> &output) {
+        const auto size   = output.size(),
+                   remain = _fill - _block + _taps - 1;
+        while (output.size() - size < remain) {
+            std::fill(_frame.begin() + _fill, _frame.end(), 0);
+            run(output);
+        }
+        output.resize(size + remain);
+        reset();
+    }
+};
+
+#endif // SIMULATION_PARTITIONED_CONVOLVER_H
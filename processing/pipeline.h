@@ -0,0 +1,270 @@
+#ifndef SIMULATION_PIPELINE_H
+#define SIMULATION_PIPELINE_H
+
+#include <vector>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * 级间流缓冲区
+ * @remarks 上游直接把输出追加到 `tail()` 返回的向量，下游以 `data()` 指针直接读取，中间不经过工作区；
+ *          已读部分只记录偏移，全部读完时整体复位，超过一半时才把未读部分移到开头。
+ *          容量不足时才扩容，稳定运行后不再分配内存。
+ * @tparam sample_t 采样点类型
+ */
+template<class sample_t>
+class stream_buffer_t {
+    std::vector<sample_t> _memory;
+    size_t                _head;
+
+public:
+    explicit stream_buffer_t(size_t capacity = 0) : _head(0) {
+        _memory.reserve(capacity);
+    }
+    
+    /// 可读点数
+    [[nodiscard]]
+    size_t size() const {
+        return _memory.size() - _head;
+    }
+    
+    /// 容量
+    [[nodiscard]]
+    size_t capacity() const {
+        return _memory.capacity();
+    }
+    
+    /// 可读部分的起点，连续 `size()` 个点有效
+    [[nodiscard]]
+    sample_t const *data() const {
+        return _memory.data() + _head;
+    }
+    
+    /// 丢弃前 n 个可读点
+    void consume(size_t n) {
+        _head += std::min(n, size());
+        if (_head == _memory.size()) clear();
+    }
+    
+    /// 清空
+    void clear() {
+        _memory.clear();
+        _head = 0;
+    }
+    
+    /// 可写端，写入方直接向其追加；调用后 `data()` 可能失效
+    std::vector<sample_t> &tail() {
+        if (_head && 2 * _head >= _memory.size()) {
+            _memory.erase(_memory.begin(), _memory.begin() + _head);
+            _head = 0;
+        }
+        return _memory;
+    }
+    
+    /// 写入 n 个点
+    void write(sample_t const *input, size_t n) {
+        auto &memory = tail();
+        memory.insert(memory.end(), input, input + n);
+    }
+};
+
+/**
+ * 流水线处理级
+ * @remarks 接口与各流式处理器一致：`process` 把一块输入的输出追加到向量，`flush` 排空内部状态。
+ */
+struct stage_t {
+    virtual ~stage_t() = default;
+    
+    virtual void process(float const *input, size_t length, std::vector<float> &output) = 0;
+    
+    virtual void flush(std::vector<float> &) {}
+    
+    virtual void reset() {}
+};
+
+namespace pipeline {
+    /// 包装具有 process/flush/reset 的流式处理器（如 `overlap_save_t`）
+    template<class processor_t>
+    struct processor_stage_t : public stage_t {
+        processor_t processor;
+        
+        explicit processor_stage_t(processor_t &&p) : processor(std::move(p)) {}
+        
+        void process(float const *input, size_t length, std::vector<float> &output) override {
+            processor.process(input, length, output);
+        }
+        
+        void flush(std::vector<float> &output) override {
+            processor.flush(output);
+        }
+        
+        void reset() override {
+            processor.reset();
+        }
+    };
+    
+    /**
+     * 包装逐点函数 float(float)，可带状态
+     * @remarks 可复制的函数对象在构造时另存一份，`reset` 以其恢复初始状态；
+     *          不可复制的函数对象无法恢复，`reset` 不改变其状态。
+     */
+    template<class function_t>
+    class map_stage_t : public stage_t {
+        constexpr static bool restorable = std::is_copy_constructible_v<function_t>;
+        
+        std::optional<function_t> _function, _initial;
+    
+    public:
+        explicit map_stage_t(function_t &&f) : _function(std::move(f)) {
+            if constexpr (restorable) _initial.emplace(*_function);
+        }
+        
+        void process(float const *input, size_t length, std::vector<float> &output) override {
+            auto &function = *_function;
+            for (auto end = input + length; input < end; ++input)
+                output.push_back(function(*input));
+        }
+        
+        void reset() override {
+            if constexpr (restorable) _function.emplace(*_initial);
+        }
+    };
+}
+
+/**
+ * 分块处理流水线
+ * @remarks 各级之间以流缓冲区相连，每级每次从上游缓冲区取至多一块数据处理，
+ *          输出直接追加到下游缓冲区，级间不另做拷贝；缓冲区在稳定运行后不再分配内存。
+ *          同一条流水线既可一次送入整段信号离线处理，也可逐块送入实时数据。
+ *          处理级须为实数输入、实数输出，复数输出的处理器（如 `analytic_signal_t`）
+ *          需经适配（如 `envelope_detector_t`）后再接入。
+ *          常用的带通、多径和加噪级见 pipeline_stages.h。
+ *
+ *     pipeline_t chain(256);
+ *     chain.then(overlap_save_t(transducer))
+ *          .then(pipeline::multipath_stage(fs, c, path_info, 4096))
+ *          .then(pipeline::noise_stage_t(10_db, pink_noise_t(), philox_t(seed)))
+ *          .then(pipeline::bandpass_stage(fs, 39e3f, 61e3f))
+ *          .then(envelope_detector_t(64));
+ *     chain.process(signal.data(), signal.size(), received);
+ *     chain.flush(received);
+ */
+class pipeline_t {
+    struct link_t {
+        std::unique_ptr<stage_t> stage;
+        stream_buffer_t<float>   input;
+    };
+    
+    size_t              _block;
+    std::vector<link_t> _links;
+    
+    /// 第 i 级的输出去向：下一级的输入缓冲区，末级为 output
+    std::vector<float> &sink(size_t i, std::vector<float> &output) {
+        return i + 1 < _links.size() ? _links[i + 1].input.tail() : output;
+    }
+    
+    /// 从第 i 级开始把各级缓冲区中的数据逐块向下游推进，末级输出追加到 output
+    void drain(size_t i, std::vector<float> &output) {
+        for (; i < _links.size(); ++i) {
+            auto &link = _links[i];
+            while (link.input.size()) {
+                const auto n = std::min(link.input.size(), _block);
+                link.stage->process(link.input.data(), n, sink(i, output));
+                link.input.consume(n);
+            }
+        }
+    }
+    
+    void append(std::unique_ptr<stage_t> stage) {
+        _links.push_back({std::move(stage), stream_buffer_t<float>(2 * _block)});
+    }
+
+public:
+    /**
+     * 构造流水线
+     * @param block 块长，各级每次至多处理这么多点，至少为 1
+     */
+    explicit pipeline_t(size_t block = 256) : _block(std::max<size_t>(block, 1)) {}
+    
+    /// 追加一级流式处理器
+    template<class processor_t>
+    pipeline_t &then(processor_t &&processor) {
+        using type = std::remove_cv_t<std::remove_reference_t<processor_t>>;
+        append(std::make_unique<pipeline::processor_stage_t<type>>(type(std::forward<processor_t>(processor))));
+        return *this;
+    }
+    
+    /// 追加一级逐点处理
+    template<class function_t>
+    pipeline_t &map(function_t &&function) {
+        using type = std::remove_cv_t<std::remove_reference_t<function_t>>;
+        append(std::make_unique<pipeline::map_stage_t<type>>(type(std::forward<function_t>(function))));
+        return *this;
+    }
+    
+    /// 追加一级自定义处理
+    pipeline_t &then(std::unique_ptr<stage_t> stage) {
+        append(std::move(stage));
+        return *this;
+    }
+    
+    /// 级数
+    [[nodiscard]]
+    size_t stages() const {
+        return _links.size();
+    }
+    
+    /// 块长
+    [[nodiscard]]
+    size_t block_size() const {
+        return _block;
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param output 末级的输出追加到此处
+     */
+    void process(float const *input, size_t length, std::vector<float> &output) {
+        if (_links.empty()) {
+            output.insert(output.end(), input, input + length);
+            return;
+        }
+        for (auto end = input + length; input < end; input += _block) {
+            _links.front().input.write(input, std::min<size_t>(_block, end - input));
+            drain(0, output);
+        }
+    }
+    
+    /// 送入一段输入，返回这次产生的输出
+    std::vector<float> process(std::vector<float> const &input) {
+        std::vector<float> output;
+        process(input.data(), input.size(), output);
+        return output;
+    }
+    
+    /**
+     * 依次排空各级，末级的输出追加到 output
+     * @param output 输出
+     */
+    void flush(std::vector<float> &output) {
+        for (size_t i = 0; i < _links.size(); ++i) {
+            _links[i].stage->flush(sink(i, output));
+            drain(i + 1, output);
+        }
+    }
+    
+    /// 各级回到初始状态
+    void reset() {
+        for (auto &link : _links) {
+            link.stage->reset();
+            link.input.clear();
+        }
+    }
+};
+
+#endif // SIMULATION_PIPELINE_H
@@ -0,0 +1,90 @@
+#ifndef SIMULATION_PIPELINE_STAGES_H
+#define SIMULATION_PIPELINE_STAGES_H
+
+#include <vector>
+
+#include "pipeline.h"
+#include "overlap_save.h"
+#include "partitioned_convolver.h"
+#include "multi_path.h"
+#include "noise_model.h"
+#include "resampler.h"
+
+namespace pipeline {
+    /**
+     * 带通级：凯泽窗 FIR 带通滤波器，以重叠保留法流式处理
+     * @remarks 输出相对输入延迟 `(taps - 1) / 2` 个点，通带增益为 1。
+     * @param fs 采样率
+     * @param f0 下限频率（为 0 时为低通）
+     * @param f1 上限频率
+     * @param taps 滤波器长度，取奇数
+     * @return 可直接接入 `pipeline_t::then` 的处理器
+     */
+    inline overlap_save_t bandpass_stage(float fs, float f0, float f1, size_t taps = 255) {
+        taps |= 1u;
+        return overlap_save_t(resampler::bandpass(taps, (taps - 1) / 2.0, f0 / fs, f1 / fs));
+    }
+    
+    /**
+     * 多径级：由多径信道描述构造冲激响应，以均匀分段卷积流式处理
+     * @remarks 与 `build_multi_path_response` 加 `convolve` 的离线计算结果相同；
+     *          声径时变或需要分数时延时使用 `multipath_channel_t`。
+     * @param fs 采样率
+     * @param c 声速
+     * @param path_info 信道描述
+     * @param length 响应长度（点）
+     * @param block 卷积块长
+     * @return 可直接接入 `pipeline_t::then` 的处理器
+     */
+    inline partitioned_convolver_t multipath_stage(
+        float fs, float c,
+        std::vector<path_info_t> const &path_info,
+        size_t length,
+        size_t block = 256
+    ) {
+        return partitioned_convolver_t(build_multi_path_response(length, fs, c, path_info), block);
+    }
+    
+    /**
+     * 加噪级：按滑动能量估计以指定信噪比叠加噪声模型的输出
+     * @remarks 构造时保存噪声模型和随机数发生器的副本，`reset` 后重放同一段噪声。
+     * @tparam model_t 噪声模型，如 `white_noise_t`、`pink_noise_t`、`band_noise_t`、`class_a_noise_t`
+     * @tparam generator_t 随机数发生器
+     */
+    template<class model_t, class generator_t>
+    class noise_stage_t {
+        db_t               _snr;
+        energy_estimator_t _estimator;
+        model_t            _model, _initial_model;
+        generator_t        _generator, _initial_generator;
+    
+    public:
+        /**
+         * 构造加噪级
+         * @param snr 信噪比
+         * @param model 噪声模型
+         * @param generator 随机数发生器
+         * @param window 能量估计的时间常数（点）
+         */
+        noise_stage_t(db_t snr, model_t model, generator_t generator, size_t window = 4096)
+            : _snr(snr), _estimator(window),
+              _model(model), _initial_model(std::move(model)),
+              _generator(generator), _initial_generator(std::move(generator)) {}
+        
+        void process(float const *input, size_t length, std::vector<float> &output) {
+            const auto size = output.size();
+            output.insert(output.end(), input, input + length);
+            add_noise(output.data() + size, length, _snr, _estimator, _model, _generator);
+        }
+        
+        void flush(std::vector<float> &) {}
+        
+        void reset() {
+            _estimator.reset();
+            _model     = _initial_model;
+            _generator = _initial_generator;
+        }
+    };
+}
+
+#endif // SIMULATION_PIPELINE_STAGES_H
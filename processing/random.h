@@ -0,0 +1,270 @@
+#ifndef SIMULATION_RANDOM_H
+#define SIMULATION_RANDOM_H
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * SplitMix64 发生器
+ * @remarks 状态只有一个 64 位整数，用于把任意种子展开成其他发生器的初始状态。
+ */
+struct splitmix64_t {
+    using result_type = uint64_t;
+    
+    uint64_t state;
+    
+    explicit splitmix64_t(uint64_t seed = 0) : state(seed) {}
+    
+    static constexpr result_type min() { return 0; }
+    
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    
+    result_type operator()() {
+        auto z = state += 0x9e3779b97f4a7c15u;
+        z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9u;
+        z = (z ^ (z >> 27u)) * 0x94d049bb133111ebu;
+        return z ^ (z >> 31u);
+    }
+};
+
+/**
+ * xoshiro256++ 发生器
+ * @remarks 周期 2^256-1，速度快，适合单线程内大量取数。
+ *          `jump()` 前进 2^128 步，可切出互不重叠的子序列。
+ */
+class xoshiro256_t {
+    uint64_t _s[4];
+    
+    static constexpr uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    using result_type = uint64_t;
+    
+    /// 由种子经 SplitMix64 展开初始状态
+    explicit xoshiro256_t(uint64_t seed = 0) {
+        splitmix64_t init(seed);
+        for (auto &s : _s) s = init();
+    }
+    
+    /// 由（种子，流序号）确定的独立流
+    xoshiro256_t(uint64_t seed, uint64_t stream) : xoshiro256_t(splitmix64_t(seed ^ splitmix64_t(stream)())()) {}
+    
+    static constexpr result_type min() { return 0; }
+    
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    
+    result_type operator()() {
+        const auto result = rotl(_s[0] + _s[3], 23) + _s[0],
+                   t      = _s[1] << 17u;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = rotl(_s[3], 45);
+        return result;
+    }
+    
+    /// 前进 2^128 步
+    void jump() {
+        constexpr uint64_t table[]{0x180ec6d33cfd0abau, 0xd5a61266f0c9392cu,
+                                   0xa9582618e03fc9aau, 0x39abdc4529b1661cu};
+        
+        uint64_t s[4]{};
+        for (auto word : table)
+            for (auto b = 0; b < 64; ++b) {
+                if (word & (uint64_t{1} << b))
+                    for (auto i = 0; i < 4; ++i) s[i] ^= _s[i];
+                (*this)();
+            }
+        for (auto i = 0; i < 4; ++i) _s[i] = s[i];
+    }
+};
+
+/**
+ * Philox4x32-10 计数器发生器
+ * @remarks 输出是（密钥，计数器）的双射函数，没有需要推进的内部状态：
+ *          以种子为密钥、以流序号为计数器高 64 位，任意多个流互相独立且可随机访问，
+ *          适合每次试验、每个线程各取一个流，结果与调度顺序无关。
+ */
+class philox_t {
+    uint32_t _key[2], _counter[4], _output[4];
+    unsigned _index;
+    
+    static void round(uint32_t c[4], uint32_t const k[2]) {
+        const auto p0 = uint64_t{0xd2511f53u} * c[0],
+                   p1 = uint64_t{0xcd9e8d57u} * c[2];
+        const uint32_t r[4]{static_cast<uint32_t>(p1 >> 32u) ^ c[1] ^ k[0],
+                            static_cast<uint32_t>(p1),
+                            static_cast<uint32_t>(p0 >> 32u) ^ c[3] ^ k[1],
+                            static_cast<uint32_t>(p0)};
+        for (auto i = 0; i < 4; ++i) c[i] = r[i];
+    }
+    
+    void refill() {
+        uint32_t k[2]{_key[0], _key[1]};
+        for (auto i = 0; i < 4; ++i) _output[i] = _counter[i];
+        for (auto i = 0; i < 10; ++i) {
+            if (i) k[0] += 0x9e3779b9u, k[1] += 0xbb67ae85u;
+            round(_output, k);
+        }
+        if (++_counter[0] == 0) ++_counter[1];
+        _index = 0;
+    }
+
+public:
+    using result_type = uint64_t;
+    
+    /**
+     * 构造发生器
+     * @param seed 种子（密钥）
+     * @param stream 流序号（计数器高 64 位）
+     * @param position 流内起始位置（以 4 个 32 位输出为一组计）
+     */
+    explicit philox_t(uint64_t seed = 0, uint64_t stream = 0, uint64_t position = 0)
+        : _key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32u)},
+          _counter{static_cast<uint32_t>(position), static_cast<uint32_t>(position >> 32u),
+                   static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32u)},
+          _output{},
+          _index(4) {}
+    
+    static constexpr result_type min() { return 0; }
+    
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    
+    /// 取一个 32 位输出
+    uint32_t next32() {
+        if (_index == 4) refill();
+        return _output[_index++];
+    }
+    
+    result_type operator()() {
+        const auto lo = next32();
+        return uint64_t{next32()} << 32u | lo;
+    }
+};
+
+namespace random_detail {
+    /// 单精度自然对数，x > 0（Cephes logf 多项式，无分支，可向量化）
+    inline float log(float x) {
+        const auto bits = std::bit_cast<uint32_t>(x);
+        auto       e    = static_cast<float>(static_cast<int>(bits >> 23u) - 126);
+        auto       m    = std::bit_cast<float>((bits & 0x007fffffu) | 0x3f000000u); // [0.5, 1)
+        
+        const auto small = m < .707106781186547524f;
+        e = small ? e - 1 : e;
+        const auto f = small ? m + m - 1 : m - 1,
+                   z = f * f;
+        
+        auto y = 7.0376836292e-2f;
+        y = y * f - 1.1514610310e-1f;
+        y = y * f + 1.1676998740e-1f;
+        y = y * f - 1.2420140846e-1f;
+        y = y * f + 1.4249322787e-1f;
+        y = y * f - 1.6668057665e-1f;
+        y = y * f + 2.0000714765e-1f;
+        y = y * f - 2.4999993993e-1f;
+        y = y * f + 3.3333331174e-1f;
+        y = y * f * z;
+        y += -2.12194440e-4f * e;
+        y += -.5f * z;
+        return f + y + .693359375f * e;
+    }
+    
+    /// 单精度 sin(2πu)、cos(2πu)，0 <= u < 1（折叠到 [-π/2, π/2] 后泰勒展开，无分支，可向量化）
+    inline void sincos_2pi(float u, float &s, float &c) {
+        // 2πu = π(x + 1)，x ∈ [-1, 1)
+        const auto x    = u + u - 1;
+        const auto fold = x > .5f || x < -.5f;
+        const auto y    = x > .5f ? 1 - x : x < -.5f ? -1 - x : x,
+                   t    = 3.14159265358979f * y,
+                   t2   = t * t;
+        
+        auto ps = -2.50521084e-8f;
+        ps = ps * t2 + 2.75573192e-6f;
+        ps = ps * t2 - 1.98412698e-4f;
+        ps = ps * t2 + 8.33333333e-3f;
+        ps = ps * t2 - 1.66666667e-1f;
+        ps = (ps * t2 + 1) * t;
+        
+        auto pc = 2.08767570e-9f;
+        pc = pc * t2 - 2.75573192e-7f;
+        pc = pc * t2 + 2.48015873e-5f;
+        pc = pc * t2 - 1.38888889e-3f;
+        pc = pc * t2 + 4.16666667e-2f;
+        pc = pc * t2 - .5f;
+        pc = pc * t2 + 1;
+        
+        s = -ps;
+        c = fold ? pc : -pc;
+    }
+    
+    /**
+     * 以 Box-Muller 变换生成或叠加高斯噪声
+     * @remarks 每 16 个点一组：先取均匀数，再在定长数组上做无分支的对数和正余弦，便于编译器向量化。
+     */
+    template<bool _add, class generator_t>
+    void gaussian(float *data, size_t length, float sigma, generator_t &generator) {
+        constexpr size_t lanes = 8;
+        constexpr auto   scale = 1.0f / (1u << 24u);
+        
+        uint32_t bits[2 * lanes];
+        float    u1[lanes], u2[lanes], r[lanes], s[lanes], c[lanes];
+        while (length) {
+            if constexpr (sizeof(typename generator_t::result_type) >= 8) {
+                for (size_t i = 0; i < lanes; ++i) {
+                    const uint64_t x = generator();
+                    bits[2 * i]     = static_cast<uint32_t>(x);
+                    bits[2 * i + 1] = static_cast<uint32_t>(x >> 32u);
+                }
+            } else {
+                for (auto &b : bits) b = static_cast<uint32_t>(generator());
+            }
+            for (size_t i = 0; i < lanes; ++i) {
+                u1[i] = static_cast<float>((bits[2 * i] >> 8u) + 1) * scale; // (0, 1]
+                u2[i] = static_cast<float>(bits[2 * i + 1] >> 8u) * scale;   // [0, 1)
+            }
+            for (size_t i = 0; i < lanes; ++i) r[i] = sigma * std::sqrt(-2 * log(u1[i]));
+            for (size_t i = 0; i < lanes; ++i) sincos_2pi(u2[i], s[i], c[i]);
+            
+            const auto n = length < 2 * lanes ? length : 2 * lanes;
+            for (size_t i = 0; i < n; ++i) {
+                const auto v = i < lanes ? r[i] * c[i] : r[i - lanes] * s[i - lanes];
+                data[i] = _add ? data[i] + v : v;
+            }
+            data += n;
+            length -= n;
+        }
+    }
+}
+
+/**
+ * 生成高斯白噪声
+ * @param data 输出
+ * @param length 点数
+ * @param sigma 标准差
+ * @param generator 随机数发生器
+ */
+template<class generator_t>
+void fill_gaussian(float *data, size_t length, float sigma, generator_t &generator) {
+    random_detail::gaussian<false>(data, length, sigma, generator);
+}
+
+/**
+ * 叠加高斯白噪声
+ * @param data 信号
+ * @param length 点数
+ * @param sigma 标准差
+ * @param generator 随机数发生器
+ */
+template<class generator_t>
+void add_gaussian(float *data, size_t length, float sigma, generator_t &generator) {
+    random_detail::gaussian<true>(data, length, sigma, generator);
+}
+
+#endif // SIMULATION_RANDOM_H
@@ -0,0 +1,324 @@
+#ifndef SIMULATION_RESAMPLER_H
+#define SIMULATION_RESAMPLER_H
+
+#include <vector>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+#include "overlap_save.h"
+
+namespace resampler {
+    /// 零阶修正贝塞尔函数
+    inline double bessel_i0(double x) {
+        double sum = 1, term = 1;
+        for (auto k = 1; term > 1e-12 * sum; ++k) {
+            term *= (x / (2 * k)) * (x / (2 * k));
+            sum += term;
+        }
+        return sum;
+    }
+    
+    /**
+     * 凯泽窗低通原型滤波器
+     * @param length 长度
+     * @param center 中心位置
+     * @param cutoff 截止频率（归一化到采样率）
+     * @param gain 通带增益
+     * @param beta 凯泽窗参数
+     * @return 冲激响应
+     */
+    inline std::vector<float> lowpass(size_t length, double center, double cutoff, double gain, double beta = 8) {
+        std::vector<float> h(length);
+        
+        const auto half = std::max(center, length - 1 - center) + 1;
+        const auto norm = bessel_i0(beta);
+        for (size_t i = 0; i < length; ++i) {
+            const auto x    = i - center,
+                       r    = x / half,
+                       w    = bessel_i0(beta * std::sqrt(std::max(0.0, 1 - r * r))) / norm,
+                       sinc = x == 0 ? 1 : std::sin(2 * M_PI * cutoff * x) / (2 * M_PI * cutoff * x);
+            h[i] = static_cast<float>(gain * 2 * cutoff * sinc * w);
+        }
+        return h;
+    }
+    
+    /**
+     * 凯泽窗带通滤波器，由两个低通原型相减得到
+     * @param length 长度
+     * @param center 中心位置
+     * @param f0 下限频率（归一化到采样率，为 0 时为低通）
+     * @param f1 上限频率（归一化到采样率）
+     * @param gain 通带增益
+     * @return 冲激响应
+     */
+    inline std::vector<float> bandpass(size_t length, double center, double f0, double f1, double gain = 1) {
+        auto h = lowpass(length, center, f1, gain);
+        if (f0 > 0) {
+            const auto low = lowpass(length, center, f0, gain);
+            for (size_t i = 0; i < length; ++i) h[i] -= low[i];
+        }
+        return h;
+    }
+    
+    /**
+     * 用连分数求采样率比的有理近似
+     * @param ratio 新采样率 / 原采样率
+     * @param limit 分子分母的上限
+     * @param up 分子（插值倍数）
+     * @param down 分母（抽取倍数）
+     * @return 近似的相对误差是否在 1e-6 以内
+     */
+    inline bool rational(double ratio, size_t limit, size_t &up, size_t &down) {
+        size_t p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+        auto   x  = ratio;
+        for (auto i = 0; i < 64; ++i) {
+            const auto a = static_cast<size_t>(std::floor(x));
+            const auto p = a * p1 + p0,
+                       q = a * q1 + q0;
+            if (p > limit || q > limit) break;
+            p0 = p1, q0 = q1, p1 = p, q1 = q;
+            
+            if (std::abs(static_cast<double>(p) / q - ratio) <= 1e-6 * ratio) {
+                up   = p;
+                down = q;
+                return true;
+            }
+            if (x == a) break;
+            x = 1 / (x - a);
+        }
+        return false;
+    }
+}
+
+/**
+ * 多相有理重采样器（L/M）
+ * @remarks 等效于插 L-1 个零、低通、再每 M 点抽取一点，但只计算被保留的输出点：
+ *          原型滤波器按相位拆成 L 组，每个输出点只做一组 K 点内积。
+ *          输出已补偿滤波器群延迟，第 n 个输出对应输入时刻 n·M/L；代价是 K/2 个输入点的延迟。
+ */
+class polyphase_resampler_t {
+    size_t             _up, _down, _taps;
+    std::vector<float> _phases;  // L 组，每组 K 点，逆序存放以便与历史窗口顺序内积
+    std::vector<float> _history; // 双份存放的环形缓冲，最近 K 个输入点总是连续的
+    size_t             _pos, _next, _count, _emitted;
+    
+    void push(float x, std::vector<float> &output) {
+        _history[_pos] = _history[_pos + _taps] = x;
+        _pos = (_pos + 1) % _taps;
+        ++_count;
+        
+        // _next 为下一输出点在插值域中相对最新输入点的位置
+        for (; _next < _up; _next += _down, ++_emitted) {
+            auto window = _history.data() + _pos;
+            auto phase  = _phases.data() + _next * _taps;
+            output.push_back(std::inner_product(window, window + _taps, phase, 0.0f));
+        }
+        _next -= _up;
+    }
+
+public:
+    /**
+     * 构造重采样器
+     * @param up 插值倍数 L
+     * @param down 抽取倍数 M
+     * @param taps 每相抽头数 K，取偶数；降采样时按 ⌈M/L⌉ 倍加长，保持过渡带相对新采样率的宽度
+     * @param cutoff 截止频率相对于较低的奈奎斯特频率的比例
+     */
+    polyphase_resampler_t(size_t up, size_t down, size_t taps = 32, double cutoff = .9)
+        : _up(up / std::gcd(up, down)),
+          _down(down / std::gcd(up, down)),
+          _taps((taps + taps % 2) * ((_down + _up - 1) / _up)),
+          _phases(_up * _taps),
+          _history(2 * _taps, 0) {
+        const auto length = _up * _taps;
+        const auto h      = resampler::lowpass(length, length / 2.0, cutoff * .5 / std::max(_up, _down), _up);
+        for (size_t p = 0; p < _up; ++p)
+            for (size_t k = 0; k < _taps; ++k)
+                _phases[p * _taps + _taps - 1 - k] = h[p + k * _up];
+        reset();
+    }
+    
+    /// 清除历史输入，回到初始状态
+    void reset() {
+        std::fill(_history.begin(), _history.end(), 0);
+        _pos     = 0;
+        _next    = _up * _taps / 2;
+        _count   = 0;
+        _emitted = 0;
+    }
+    
+    /// 插值倍数
+    [[nodiscard]]
+    size_t up() const {
+        return _up;
+    }
+    
+    /// 抽取倍数
+    [[nodiscard]]
+    size_t down() const {
+        return _down;
+    }
+    
+    /// 输出相对输入的延迟（输入点数）
+    [[nodiscard]]
+    size_t latency() const {
+        return _taps / 2;
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param output 产生的输出追加到此处
+     */
+    void process(float const *input, size_t length, std::vector<float> &output) {
+        for (auto end = input + length; input < end; ++input) push(*input, output);
+    }
+    
+    /// 送入一段输入，返回这次产生的输出
+    std::vector<float> process(std::vector<float> const &input) {
+        std::vector<float> output;
+        process(input.data(), input.size(), output);
+        return output;
+    }
+    
+    /**
+     * 以 0 补齐，输出对应已送入输入时段的剩余点
+     * @param output 输出追加到此处
+     */
+    void flush(std::vector<float> &output) {
+        const auto total = (_count * _up + _down - 1) / _down;
+        for (auto i = latency(); i && _emitted < total; --i) push(0, output);
+        output.resize(output.size() - (_emitted - std::min(_emitted, total)));
+        reset();
+    }
+};
+
+/**
+ * Farrow 结构任意比例重采样器（三次拉格朗日插值）
+ * @remarks 每个输出点由相邻 4 个输入点的三次多项式在小数位置处求值，比例可以是任意实数。
+ *          不含抗混叠滤波，降采样时须先把输入低通到新采样率的奈奎斯特频率以下。
+ */
+class farrow_resampler_t {
+    double _step, _time;
+    float  _x[4];
+    size_t _count, _emitted;
+    
+    void push(float x, std::vector<float> &output) {
+        _x[0] = _x[1], _x[1] = _x[2], _x[2] = _x[3], _x[3] = x;
+        ++_count;
+        
+        // _time 为下一输出点相对最新输入点的位置，落在 [-2, -1) 时 4 个相邻点都已到达
+        for (; _time < -1; _time += _step, ++_emitted) {
+            const auto mu = static_cast<float>(_time + 2),
+                       c0 = _x[1],
+                       c1 = _x[2] - _x[0] / 3 - _x[1] / 2 - _x[3] / 6,
+                       c2 = (_x[0] + _x[2]) / 2 - _x[1],
+                       c3 = (_x[3] - _x[0]) / 6 + (_x[1] - _x[2]) / 2;
+            output.push_back(((c3 * mu + c2) * mu + c1) * mu + c0);
+        }
+        _time -= 1;
+    }
+
+public:
+    /**
+     * 构造重采样器
+     * @param ratio 新采样率 / 原采样率
+     */
+    explicit farrow_resampler_t(double ratio) : _step(1 / ratio) {
+        reset();
+    }
+    
+    /// 清除历史输入，回到初始状态
+    void reset() {
+        std::fill(_x, _x + 4, 0);
+        _time    = 0;
+        _count   = 0;
+        _emitted = 0;
+    }
+    
+    /// 输出相对输入的延迟（输入点数）
+    [[nodiscard]]
+    size_t latency() const {
+        return 2;
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param output 产生的输出追加到此处
+     */
+    void process(float const *input, size_t length, std::vector<float> &output) {
+        for (auto end = input + length; input < end; ++input) push(*input, output);
+    }
+    
+    /// 送入一段输入，返回这次产生的输出
+    std::vector<float> process(std::vector<float> const &input) {
+        std::vector<float> output;
+        process(input.data(), input.size(), output);
+        return output;
+    }
+    
+    /**
+     * 以 0 补齐，输出对应已送入输入时段的剩余点
+     * @param output 输出追加到此处
+     */
+    void flush(std::vector<float> &output) {
+        const auto total = static_cast<size_t>(std::ceil(_count / _step));
+        for (auto i = latency(); i && _emitted < total; --i) push(0, output);
+        output.resize(output.size() - (_emitted - std::min(_emitted, total)));
+        reset();
+    }
+};
+
+/**
+ * 多相重采样
+ * @remarks 采样率比能化为分子分母都不超过 `limit` 的分数时使用多相有理重采样器，
+ *          否则用 Farrow 重采样器，降采样时先以 FIR 低通抗混叠。
+ *          与 `resample` 不同，不需要大倍率升采样和超长变换，计算量只与输出点数成正比。
+ * @param signal 原信号
+ * @param f0 原采样率
+ * @param f1 新采样率
+ * @param size1 新信号长度（点数不够将补 0）
+ * @param limit 有理近似分子分母上限
+ * @return 重采样信号
+ */
+inline std::vector<float> resample_polyphase(
+    std::vector<float> const &signal,
+    float f0,
+    float f1,
+    size_t size1,
+    size_t limit = 1024
+) {
+    std::vector<float> target;
+    target.reserve(size1);
+    
+    const auto ratio = static_cast<double>(f1) / f0;
+    size_t     up, down;
+    if (resampler::rational(ratio, limit, up, down)) {
+        polyphase_resampler_t resampler(up, down);
+        resampler.process(signal.data(), signal.size(), target);
+        resampler.flush(target);
+    } else {
+        farrow_resampler_t resampler(ratio);
+        if (ratio < 1) {
+            // 先低通到新奈奎斯特频率以下，并去掉滤波器群延迟
+            constexpr size_t taps = 64;
+            overlap_save_t   filter(resampler::lowpass(taps + 1, taps / 2.0, .45 * ratio, 1));
+            
+            std::vector<float> filtered;
+            filter.process(signal.data(), signal.size(), filtered);
+            filter.flush(filtered);
+            resampler.process(filtered.data() + taps / 2, signal.size(), target);
+        } else
+            resampler.process(signal.data(), signal.size(), target);
+        resampler.flush(target);
+    }
+    
+    target.resize(size1, 0);
+    return target;
+}
+
+#endif // SIMULATION_RESAMPLER_H
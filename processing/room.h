@@ -0,0 +1,176 @@
+#ifndef SIMULATION_ROOM_H
+#define SIMULATION_ROOM_H
+
+#include <vector>
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+#include "multi_path.h"
+
+/// 空间点（二维时 z 恒为 0）
+struct point_t {
+    float x, y, z;
+    
+    point_t operator+(point_t const &others) const { return {x + others.x, y + others.y, z + others.z}; }
+    
+    point_t operator-(point_t const &others) const { return {x - others.x, y - others.y, z - others.z}; }
+    
+    point_t operator*(float k) const { return {x * k, y * k, z * k}; }
+    
+    [[nodiscard]]
+    float dot(point_t const &others) const { return x * others.x + y * others.y + z * others.z; }
+    
+    [[nodiscard]]
+    point_t cross(point_t const &others) const {
+        return {y * others.z - z * others.y, z * others.x - x * others.z, x * others.y - y * others.x};
+    }
+    
+    [[nodiscard]]
+    float norm() const { return std::sqrt(dot(*this)); }
+};
+
+/**
+ * 矩形反射面（障碍物）
+ * @param origin 一个顶点
+ * @param u 一条边
+ * @param v 另一条边（须与 u 垂直）
+ * @param beta 反射系数（幅度）
+ */
+struct reflector_t {
+    point_t origin, u, v;
+    float   beta;
+};
+
+/**
+ * 镜像声源法房间模型
+ * @remarks 长方体房间 [0,Lx]×[0,Ly]×[0,Lz]（Lz 为 0 时退化为二维矩形）。
+ *          镜像声源只与发射端有关，构造时一次生成并按到房间中心的距离排序；
+ *          对每个接收点，距离超出上限的镜像由排序直接截断，无需逐个计算，
+ *          因此同一发射端可以很快地为成千上万个接收点生成信道描述。
+ *          房间内的矩形障碍物只计一次反射，并检查镜面反射点是否落在反射面内。
+ */
+class image_source_model_t {
+    struct image_t {
+        point_t position;
+        float   gain;    // 各面反射系数之积
+        int     reflect_times;
+        float   radius;  // 到房间中心的距离
+    };
+    
+    point_t                  _size, _source, _center;
+    float                    _half_diagonal;
+    std::vector<image_t>     _images;
+    std::vector<reflector_t> _reflectors;
+    
+    /// 一维镜像：位置、两面各自的反射次数
+    static void mirror(float s, float l, int n, int q, float &position, int &near, int &far) {
+        position = (1 - 2 * q) * s + 2 * n * l;
+        near     = std::abs(n - q);
+        far      = std::abs(n);
+    }
+
+public:
+    /**
+     * 构造房间模型
+     * @param size 房间尺寸
+     * @param source 发射端位置
+     * @param beta 六个面的反射系数（x=0, x=Lx, y=0, y=Ly, z=0, z=Lz）
+     * @param max_order 最高反射阶数
+     * @param reflectors 房间内的障碍物
+     */
+    image_source_model_t(
+        point_t size,
+        point_t source,
+        std::array<float, 6> beta,
+        int max_order,
+        std::vector<reflector_t> reflectors = {}
+    ) : _size(size), _source(source), _center(size * .5f),
+        _half_diagonal(_center.norm()), _reflectors(std::move(reflectors)) {
+        const auto flat = size.z == 0;
+        const auto nz   = flat ? 0 : max_order;
+        
+        for (auto ix = -max_order; ix <= max_order; ++ix)
+            for (auto iy = -max_order; iy <= max_order; ++iy)
+                for (auto iz = -nz; iz <= nz; ++iz)
+                    for (auto qx = 0; qx < 2; ++qx)
+                        for (auto qy = 0; qy < 2; ++qy)
+                            for (auto qz = 0; qz < (flat ? 1 : 2); ++qz) {
+                                image_t image{};
+                                int     x0, x1, y0, y1, z0 = 0, z1 = 0;
+                                mirror(source.x, size.x, ix, qx, image.position.x, x0, x1);
+                                mirror(source.y, size.y, iy, qy, image.position.y, y0, y1);
+                                if (flat)
+                                    image.position.z = source.z;
+                                else
+                                    mirror(source.z, size.z, iz, qz, image.position.z, z0, z1);
+                                
+                                image.reflect_times = x0 + x1 + y0 + y1 + z0 + z1;
+                                if (image.reflect_times == 0 || image.reflect_times > max_order) continue;
+                                
+                                image.gain = std::pow(beta[0], x0) * std::pow(beta[1], x1)
+                                             * std::pow(beta[2], y0) * std::pow(beta[3], y1)
+                                             * std::pow(beta[4], z0) * std::pow(beta[5], z1);
+                                image.radius = (image.position - _center).norm();
+                                _images.push_back(image);
+                            }
+        
+        std::sort(_images.begin(), _images.end(),
+                  [](image_t const &a, image_t const &b) { return a.radius < b.radius; });
+    }
+    
+    /// 镜像声源数
+    [[nodiscard]]
+    size_t images() const {
+        return _images.size();
+    }
+    
+    /**
+     * 生成接收点的信道描述
+     * @param receiver 接收端位置（须在房间内）
+     * @param max_ds 最大额外路程（米），通常取响应长度对应的路程
+     * @param threshold 相对直达径的增益下限，更弱的声径被剪除
+     * @return 各反射声径（不含直达径），增益含球面扩散
+     */
+    [[nodiscard]]
+    std::vector<path_info_t> paths(point_t receiver, float max_ds, float threshold = 1e-3f) const {
+        std::vector<path_info_t> result;
+        
+        const auto d0    = std::max((receiver - _source).norm(), 1e-6f);
+        const auto limit = std::min(d0 + max_ds, d0 / threshold);
+        
+        // 接收点在房间内，镜像到接收点的距离不小于 radius - 半对角线
+        for (auto const &image : _images) {
+            if (image.radius - _half_diagonal > limit) break;
+            
+            const auto d = (receiver - image.position).norm(),
+                       a = image.gain * d0 / d;
+            if (d - d0 > max_ds || a < threshold) continue;
+            result.push_back({a, d - d0, image.reflect_times});
+        }
+        
+        for (auto const &reflector : _reflectors) {
+            const auto normal = reflector.u.cross(reflector.v);
+            const auto n      = normal * (1 / normal.norm());
+            const auto h      = (_source - reflector.origin).dot(n);
+            const auto mirror = _source - n * (2 * h);
+            
+            // 镜像到接收点的连线与反射面的交点须落在矩形内，且收发在同侧
+            const auto hr = (receiver - reflector.origin).dot(n);
+            if (h * hr <= 0) continue;
+            const auto t     = h / (h + hr);
+            const auto point = mirror + (receiver - mirror) * t - reflector.origin;
+            const auto s0    = point.dot(reflector.u) / reflector.u.dot(reflector.u),
+                       s1    = point.dot(reflector.v) / reflector.v.dot(reflector.v);
+            if (s0 < 0 || s0 > 1 || s1 < 0 || s1 > 1) continue;
+            
+            const auto d = (receiver - mirror).norm(),
+                       a = reflector.beta * d0 / d;
+            if (d - d0 > max_ds || a < threshold) continue;
+            result.push_back({a, d - d0, 1});
+        }
+        return result;
+    }
+};
+
+#endif // SIMULATION_ROOM_H
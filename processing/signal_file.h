@@ -0,0 +1,377 @@
+#ifndef SIMULATION_SIGNAL_FILE_H
+#define SIMULATION_SIGNAL_FILE_H
+
+#include <bit>
+#include <string>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <stdexcept>
+#include <condition_variable>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "../signal/complex_t.hpp"
+
+static_assert(std::endian::native == std::endian::little, "signal file payload is little-endian");
+
+/// 信号文件采样点类型
+enum class sample_type_t : uint16_t {
+    f32 = 0,
+    f64 = 1,
+    i16 = 2,
+    u16 = 3,
+    c32 = 4, // complex_t
+};
+
+template<class sample_t>
+constexpr sample_type_t sample_type_of();
+
+template<>
+constexpr sample_type_t sample_type_of<float>() { return sample_type_t::f32; }
+
+template<>
+constexpr sample_type_t sample_type_of<double>() { return sample_type_t::f64; }
+
+template<>
+constexpr sample_type_t sample_type_of<int16_t>() { return sample_type_t::i16; }
+
+template<>
+constexpr sample_type_t sample_type_of<uint16_t>() { return sample_type_t::u16; }
+
+template<>
+constexpr sample_type_t sample_type_of<complex_t>() { return sample_type_t::c32; }
+
+/// 采样点字节数
+constexpr size_t sample_size(sample_type_t type) {
+    switch (type) {
+        case sample_type_t::f32:
+            return 4;
+        case sample_type_t::f64:
+        case sample_type_t::c32:
+            return 8;
+        case sample_type_t::i16:
+        case sample_type_t::u16:
+            return 2;
+    }
+    return 0;
+}
+
+/**
+ * 信号文件头（32 字节，小端）
+ * @remarks 文件头之后是交错存放的多通道采样点，共 `length * channels` 个。
+ */
+struct signal_header_t {
+    char          magic[4]{'S', 'I', 'G', 'F'};
+    uint16_t      version  = 1;
+    sample_type_t type     = sample_type_t::f32;
+    uint32_t      channels = 1;
+    uint32_t      reserved = 0;
+    double        fs       = 0;
+    uint64_t      length   = 0; // 每通道点数
+    
+    [[nodiscard]]
+    bool valid() const {
+        return std::memcmp(magic, "SIGF", 4) == 0 && version == 1 && sample_size(type) && channels;
+    }
+};
+
+static_assert(sizeof(signal_header_t) == 32, "signal header must be 32 bytes");
+
+/**
+ * 内存映射的只读信号文件
+ * @remarks 采样点直接在映射内存上访问，不经过拷贝；文件大小只受地址空间限制。
+ */
+class mapped_signal_t {
+    signal_header_t _header;
+    void            *_memory = nullptr;
+    size_t          _bytes   = 0;
+#ifdef _WIN32
+    HANDLE _file = INVALID_HANDLE_VALUE, _mapping = nullptr;
+#endif
+    
+    void close() {
+#ifdef _WIN32
+        if (_memory) UnmapViewOfFile(_memory);
+        if (_mapping) CloseHandle(_mapping);
+        if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+        _file    = INVALID_HANDLE_VALUE;
+        _mapping = nullptr;
+#else
+        if (_memory) munmap(_memory, _bytes);
+#endif
+        _memory = nullptr;
+        _bytes  = 0;
+    }
+
+public:
+    explicit mapped_signal_t(std::string const &file_name) {
+#ifdef _WIN32
+        _file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER size;
+        if (_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file, &size))
+            throw std::runtime_error("cannot open " + file_name);
+        _bytes   = static_cast<size_t>(size.QuadPart);
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        _memory  = _mapping ? MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+#else
+        const auto fd = ::open(file_name.c_str(), O_RDONLY);
+        struct stat st{};
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            if (fd >= 0) ::close(fd);
+            throw std::runtime_error("cannot open " + file_name);
+        }
+        _bytes  = static_cast<size_t>(st.st_size);
+        _memory = _bytes ? mmap(nullptr, _bytes, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+        if (_memory == MAP_FAILED) _memory = nullptr;
+        ::close(fd);
+        if (_memory) madvise(_memory, _bytes, MADV_SEQUENTIAL);
+#endif
+        if (!_memory || _bytes < sizeof(signal_header_t)) {
+            close();
+            throw std::runtime_error("cannot map " + file_name);
+        }
+        std::memcpy(&_header, _memory, sizeof _header);
+        // 以除法比较，损坏的文件头中的长度不会使乘积溢出而通过检查
+        if (!_header.valid() ||
+            _header.length > (_bytes - sizeof _header) / sample_size(_header.type) / _header.channels) {
+            close();
+            throw std::runtime_error("bad signal file " + file_name);
+        }
+    }
+    
+    mapped_signal_t(mapped_signal_t const &) = delete;
+    
+    mapped_signal_t &operator=(mapped_signal_t const &) = delete;
+    
+    ~mapped_signal_t() {
+        close();
+    }
+    
+    [[nodiscard]]
+    signal_header_t const &header() const {
+        return _header;
+    }
+    
+    /// 每通道点数
+    [[nodiscard]]
+    size_t size() const {
+        return _header.length;
+    }
+    
+    /**
+     * 采样点（交错存放的各通道）
+     * @tparam sample_t 采样点类型，须与文件一致
+     */
+    template<class sample_t>
+    sample_t const *data() const {
+        if (sample_type_of<sample_t>() != _header.type)
+            throw std::runtime_error("sample type mismatch");
+        return reinterpret_cast<sample_t const *>(static_cast<char const *>(_memory) + sizeof _header);
+    }
+    
+    /// 复制一个通道
+    template<class sample_t>
+    std::vector<sample_t> channel(size_t index = 0) const {
+        if (index >= _header.channels) throw std::runtime_error("no such channel");
+        auto                  p = data<sample_t>() + index;
+        std::vector<sample_t> result(size());
+        for (auto &x : result) x = *p, p += _header.channels;
+        return result;
+    }
+};
+
+/**
+ * 信号文件写入器
+ * @remarks 采样点先写入缓冲区，缓冲区满时交给后台线程写盘，同时切换到另一块缓冲区继续接收，
+ *          调用方不等待磁盘。关闭时补写文件头中的长度。
+ *          写盘失败时 `write` 或 `close` 抛出异常；析构时不报告错误，需要确认写入成功时应显式调用 `close`。
+ * @tparam sample_t 采样点类型
+ */
+template<class sample_t>
+class signal_writer_t {
+    std::FILE               *_file;
+    signal_header_t         _header;
+    std::vector<sample_t>   _buffers[2];
+    size_t                  _active;
+    uint64_t                _samples; // 已写入的采样点总数，关闭时折算为每通道点数
+    bool                    _busy, _stop, _failed;
+    std::mutex              _mutex;
+    std::condition_variable _signal;
+    std::thread             _thread;
+    
+    void work() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _signal.wait(lock, [this] { return _busy || _stop; });
+            if (!_busy) return;
+            
+            auto       &buffer = _buffers[1 - _active];
+            const auto skip    = _failed;
+            lock.unlock();
+            const auto ok = skip || std::fwrite(buffer.data(), sizeof(sample_t), buffer.size(), _file) == buffer.size();
+            buffer.clear();
+            lock.lock();
+            _failed = _failed || !ok;
+            _busy   = false;
+            _signal.notify_all();
+        }
+    }
+    
+    /// 交出当前缓冲区，返回此前的写盘是否都成功
+    bool swap() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _signal.wait(lock, [this] { return !_busy; });
+        _active = 1 - _active;
+        _busy   = true;
+        _signal.notify_all();
+        return !_failed;
+    }
+
+public:
+    /**
+     * 创建信号文件
+     * @param file_name 文件名
+     * @param fs 采样率
+     * @param channels 通道数，至少为 1
+     * @param buffer 每块缓冲区的点数，至少为 1
+     */
+    explicit signal_writer_t(std::string const &file_name, double fs = 0, uint32_t channels = 1,
+                             size_t buffer = 1u << 18u)
+        : _file(nullptr), _active(0), _samples(0), _busy(false), _stop(false), _failed(false) {
+        if (channels == 0) throw std::invalid_argument("signal file needs at least one channel");
+        _file = std::fopen(file_name.c_str(), "wb");
+        if (!_file) throw std::runtime_error("cannot create " + file_name);
+        _header.type     = sample_type_of<sample_t>();
+        _header.channels = channels;
+        _header.fs       = fs;
+        if (std::fwrite(&_header, sizeof _header, 1, _file) != 1) {
+            std::fclose(_file);
+            throw std::runtime_error("cannot write " + file_name);
+        }
+        
+        for (auto &b : _buffers) b.reserve(std::max<size_t>(buffer, 1));
+        _thread = std::thread([this] { work(); });
+    }
+    
+    signal_writer_t(signal_writer_t const &) = delete;
+    
+    signal_writer_t &operator=(signal_writer_t const &) = delete;
+    
+    ~signal_writer_t() {
+        try {
+            close();
+        } catch (std::runtime_error const &) {}
+    }
+    
+    /// 写入 n 个采样点（多通道时为交错存放的帧，可以跨次调用拼成整帧）
+    void write(sample_t const *data, size_t n) {
+        _samples += n;
+        while (n) {
+            auto       &buffer = _buffers[_active];
+            const auto count   = std::min(n, buffer.capacity() - buffer.size());
+            buffer.insert(buffer.end(), data, data + count);
+            data += count;
+            n -= count;
+            if (buffer.size() == buffer.capacity() && !swap())
+                throw std::runtime_error("signal file write failed");
+        }
+    }
+    
+    void write(std::vector<sample_t> const &data) {
+        write(data.data(), data.size());
+    }
+    
+    /// 写出剩余数据、补写文件头并关闭，不足一帧的尾部不计入长度
+    void close() {
+        if (!_file) return;
+        
+        swap();
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _signal.wait(lock, [this] { return !_busy; });
+            _stop = true;
+            _signal.notify_all();
+        }
+        _thread.join();
+        
+        _header.length = _samples / _header.channels;
+        
+        auto ok = !_failed;
+        ok = std::fseek(_file, 0, SEEK_SET) == 0 && std::fwrite(&_header, sizeof _header, 1, _file) == 1 && ok;
+        ok = std::fclose(_file) == 0 && ok;
+        _file = nullptr;
+        if (!ok) throw std::runtime_error("signal file write failed");
+    }
+};
+
+/**
+ * 保存数字信号到二进制文件
+ * @remarks 按写入器的块大小分块写盘，额外内存不超过两块缓冲区，与信号长度无关。
+ * @param file_name 文件名
+ * @param signal 信号
+ * @param fs 采样率
+ */
+template<class sample_t>
+void save_signal_binary(std::string const &file_name, std::vector<sample_t> const &signal, double fs = 0) {
+    signal_writer_t<sample_t> writer(file_name, fs, 1, std::clamp<size_t>(signal.size(), 1, 1u << 16u));
+    writer.write(signal);
+    writer.close();
+}
+
+/**
+ * 从二进制文件读取数字信号（第一通道）
+ * @param file_name 文件名
+ * @return 数字信号
+ */
+template<class sample_t>
+std::vector<sample_t> load_signal_binary(std::string const &file_name) {
+    return mapped_signal_t(file_name).channel<sample_t>();
+}
+
+/**
+ * 把二进制信号文件导出为文本，每行一帧，通道间以逗号分隔
+ * @tparam sample_t 采样点类型，须与文件一致
+ * @param file_name 二进制文件名
+ * @param text_name 文本文件名
+ */
+template<class sample_t>
+void export_signal_text(std::string const &file_name, std::string const &text_name) {
+    mapped_signal_t signal(file_name);
+    std::ofstream   file(text_name);
+    
+    const auto channels = signal.header().channels;
+    auto       p        = signal.data<sample_t>();
+    for (size_t i = 0; i < signal.size(); ++i) {
+        for (size_t j = 0; j < channels; ++j, ++p) {
+            if (j) file << ',';
+            if constexpr (std::is_same_v<sample_t, complex_t>)
+                file << p->re << ',' << p->im;
+            else
+                file << *p;
+        }
+        file << '\n';
+    }
+}
+
+#endif // SIMULATION_SIGNAL_FILE_H
@@ -6,12 +6,16 @@
 #define SIMULATION_SIGNAL_PROCESS_H
 
 #include <vector>
+#include <span>
 #include <array>
 #include <algorithm>
 
 #include "../signal/complex_t.hpp"
+#include "../signal/split_complex_t.hpp"
 #include "static_check.h"
 #include "fft.h"
+#include "arena.h"
+#include "parallel_fft.h"
 
 /**
  * 切片并复制向量
@@ -50,12 +54,533 @@ void normalize(
         n = n * target / max;
 }
 
+/**
+ * 实信号快速傅里叶正变换
+ * @param signal 原信号（不足变换长度补 0，超出部分忽略）
+ * @param plan 实变换计划
+ * @return 非负频率部分的频谱，共 `n / 2 + 1` 点
+ */
+inline std::vector<complex_t> rfft(std::vector<float> const &signal, rfft_plan_t const &plan) {
+    std::vector<complex_t> spectrum(plan.size() / 2 + 1, complex_t::zero);
+    std::copy(signal.begin(), signal.begin() + std::min(signal.size(), plan.size()),
+              reinterpret_cast<float *>(spectrum.data()));
+    plan.forward(spectrum.data());
+    return spectrum;
+}
+
+/// 实信号快速傅里叶正变换（运行时长度，必须是偶数）
+inline std::vector<complex_t> rfft(std::vector<float> const &signal, size_t size) {
+    return rfft(signal, cached_plan<rfft_plan_t>(size));
+}
+
+/**
+ * 实信号快速傅里叶正变换
+ * @tparam _size 变换长度，必须是偶数
+ * @param signal 原信号（不足 `_size` 补 0）
+ * @return 非负频率部分的频谱，共 `_size / 2 + 1` 点
+ */
+template<auto _size>
+std::vector<complex_t> rfft(std::vector<float> const &signal) {
+    static_assert(_size % 2 == 0, "size is not even");
+    
+    return rfft(signal, rfft_plan<_size>::instance());
+}
+
+/**
+ * 实信号快速傅里叶反变换
+ * @param spectrum 非负频率部分的频谱，共 `n / 2 + 1` 点，将被用作工作区
+ * @param plan 实变换计划
+ * @return 实信号
+ */
+inline std::vector<float> irfft(std::vector<complex_t> &spectrum, rfft_plan_t const &plan) {
+    plan.inverse(spectrum.data());
+    auto p = reinterpret_cast<float const *>(spectrum.data());
+    return std::vector<float>(p, p + plan.size());
+}
+
+/// 实信号快速傅里叶反变换（运行时长度，必须是偶数）
+inline std::vector<float> irfft(std::vector<complex_t> &spectrum, size_t size) {
+    return irfft(spectrum, cached_plan<rfft_plan_t>(size));
+}
+
+/**
+ * 实信号快速傅里叶反变换
+ * @tparam _size 变换长度，必须是偶数
+ * @param spectrum 非负频率部分的频谱，共 `_size / 2 + 1` 点，将被用作工作区
+ * @return 实信号
+ */
+template<auto _size>
+std::vector<float> irfft(std::vector<complex_t> &spectrum) {
+    static_assert(_size % 2 == 0, "size is not even");
+    
+    return irfft(spectrum, rfft_plan<_size>::instance());
+}
+
+/**
+ * 实信号快速傅里叶正变换，结果分离存储
+ * @param signal 原信号（不足变换长度补 0，超出部分忽略）
+ * @param plan 实变换计划
+ * @return 非负频率部分的频谱，共 `n / 2 + 1` 点
+ */
+inline split_complex_t rfft_split(std::vector<float> const &signal, rfft_plan_t const &plan) {
+    split_complex_t spectrum(plan.size() / 2 + 1);
+    for (size_t     i = 0; i < std::min(signal.size(), plan.size()); ++i)
+        (i & 1u ? spectrum.im : spectrum.re)[i / 2] = signal[i];
+    plan.forward(spectrum.re.data(), spectrum.im.data());
+    return spectrum;
+}
+
+/// 实信号快速傅里叶正变换，结果分离存储（运行时长度，必须是偶数）
+inline split_complex_t rfft_split(std::vector<float> const &signal, size_t size) {
+    return rfft_split(signal, cached_plan<rfft_plan_t>(size));
+}
+
+/**
+ * 实信号快速傅里叶正变换，结果分离存储
+ * @tparam _size 变换长度，必须是偶数
+ * @param signal 原信号（不足 `_size` 补 0）
+ * @return 非负频率部分的频谱，共 `_size / 2 + 1` 点
+ */
+template<auto _size>
+split_complex_t rfft_split(std::vector<float> const &signal) {
+    static_assert(_size % 2 == 0, "size is not even");
+    
+    return rfft_split(signal, rfft_plan<_size>::instance());
+}
+
+/**
+ * 实信号快速傅里叶反变换，频谱分离存储
+ * @param spectrum 非负频率部分的频谱，共 `n / 2 + 1` 点，将被用作工作区
+ * @param plan 实变换计划
+ * @return 实信号
+ */
+inline std::vector<float> irfft(split_complex_t &spectrum, rfft_plan_t const &plan) {
+    plan.inverse(spectrum.re.data(), spectrum.im.data());
+    std::vector<float> signal(plan.size());
+    for (size_t        i = 0; i < signal.size(); ++i)
+        signal[i] = (i & 1u ? spectrum.im : spectrum.re)[i / 2];
+    return signal;
+}
+
+/// 实信号快速傅里叶反变换，频谱分离存储（运行时长度，必须是偶数）
+inline std::vector<float> irfft(split_complex_t &spectrum, size_t size) {
+    return irfft(spectrum, cached_plan<rfft_plan_t>(size));
+}
+
+/**
+ * 实信号快速傅里叶反变换，频谱分离存储
+ * @tparam _size 变换长度，必须是偶数
+ * @param spectrum 非负频率部分的频谱，共 `_size / 2 + 1` 点，将被用作工作区
+ * @return 实信号
+ */
+template<auto _size>
+std::vector<float> irfft(split_complex_t &spectrum) {
+    static_assert(_size % 2 == 0, "size is not even");
+    
+    return irfft(spectrum, rfft_plan<_size>::instance());
+}
+
+/**
+ * 切片视图
+ * @remarks 与 `slice` 相同的范围，但不复制数据。
+ * @tparam sample_t 采样点类型
+ * @param vec 原向量
+ * @param begin 起点下标
+ * @param length 长度
+ * @return 切片视图
+ */
+template<class sample_t>
+std::span<sample_t const> slice_view(
+    std::vector<sample_t> const &vec,
+    size_t begin,
+    size_t length = -1
+) {
+    begin = std::min(begin, vec.size());
+    return {vec.data() + begin, std::min(length, vec.size() - begin)};
+}
+
+/**
+ * 实信号快速傅里叶正变换，写入调用方提供的存储
+ * @param signal 原信号（不足变换长度补 0，超出部分忽略）
+ * @param spectrum 输出，至少 `n / 2 + 1` 点
+ * @param plan 实变换计划
+ */
+inline void rfft(std::span<float const> signal, std::span<complex_t> spectrum, rfft_plan_t const &plan) {
+    const auto n = std::min(signal.size(), plan.size());
+    std::fill(spectrum.begin(), spectrum.begin() + plan.size() / 2 + 1, complex_t::zero);
+    std::copy(signal.begin(), signal.begin() + n, reinterpret_cast<float *>(spectrum.data()));
+    plan.forward(spectrum.data());
+}
+
+/**
+ * 实信号快速傅里叶反变换，写入调用方提供的存储
+ * @param spectrum 非负频率部分的频谱，共 `n / 2 + 1` 点，将被用作工作区
+ * @param signal 输出，写入前 min(n, signal.size()) 点
+ * @param plan 实变换计划
+ */
+inline void irfft(std::span<complex_t> spectrum, std::span<float> signal, rfft_plan_t const &plan) {
+    plan.inverse(spectrum.data());
+    auto p = reinterpret_cast<float const *>(spectrum.data());
+    std::copy(p, p + std::min(signal.size(), plan.size()), signal.begin());
+}
+
+/**
+ * 用 FFT 变换实信号，写入调用方提供的存储
+ * @param signal 原信号
+ * @param spectrum 输出，长度即变换长度
+ */
+inline void fft_real(std::span<float const> signal, std::span<complex_t> spectrum) {
+    const auto size = spectrum.size();
+    if (size % 2 == 0) {
+        // 由半谱按共轭对称补全
+        rfft(signal, spectrum, cached_plan<rfft_plan_t>(size));
+        for (size_t i = size / 2 + 1; i < size; ++i)
+            spectrum[i] = spectrum[size - i].conjugate();
+    } else {
+        const auto n = std::min(signal.size(), size);
+        std::fill(spectrum.begin(), spectrum.end(), complex_t::zero);
+        std::transform(signal.begin(), signal.begin() + n, spectrum.begin(),
+                       [](float z) -> complex_t { return {z, 0}; });
+        fft(spectrum.data(), size);
+    }
+}
+
+/**
+ * 快速卷积，写入调用方提供的存储
+ * @remarks 两路频谱取自当前线程的临时内存区，稳定运行时不申请堆内存。
+ * @param a 信号a
+ * @param b 信号b
+ * @param result 输出，写入前 min(n, result.size()) 点
+ * @param plan 实变换计划，决定计算长度
+ */
+inline void convolve(
+    std::span<float const> a,
+    std::span<float const> b,
+    std::span<float> result,
+    rfft_plan_t const &plan
+) {
+    arena_scope_t scope;
+    
+    const auto half = plan.size() / 2 + 1;
+    auto       fa   = scope.allocate<complex_t>(half),
+               fb   = scope.allocate<complex_t>(half);
+    rfft(a, fa, plan);
+    rfft(b, fb, plan);
+    for (size_t i = 0; i < half; ++i) fa[i] *= fb[i];
+    irfft(fa, result, plan);
+}
+
+/**
+ * 希尔伯特变换，写入调用方提供的存储
+ * @param x 原信号
+ * @param result 输出，写入前 min(x.size(), result.size()) 点
+ * @param plan 实变换计划
+ */
+inline void hilbert(std::span<float const> x, std::span<complex_t> result, rfft_plan_t const &plan) {
+    arena_scope_t scope;
+    
+    // 生成超前 90° 的信号（虚部）
+    // 实信号只需处理正频率部分，负频率部分由共轭对称自然得到
+    auto spectrum = scope.allocate<complex_t>(plan.size() / 2 + 1);
+    rfft(x, spectrum, plan);
+    for (auto p = spectrum.begin() + 1; p < spectrum.end() - 1; ++p)
+        *p = {p->im, -p->re};
+    plan.inverse(spectrum.data());
+    
+    // 与原信号合并为复信号
+    auto       imaginary = reinterpret_cast<float const *>(spectrum.data());
+    const auto n         = std::min({x.size(), result.size(), plan.size()});
+    for (size_t i = 0; i < n; ++i)
+        result[i] = {x[i], imaginary[i]};
+}
+
+/**
+ * 互相关（静态部分），写入调用方提供的滤波器谱
+ * @param signal 原信号
+ * @param filter 输出，尺寸已为 `n / 2 + 1` 时不重新申请内存
+ * @param plan 实变换计划
+ */
+inline void xcorr_init(std::span<float const> signal, split_complex_t &filter, rfft_plan_t const &plan) {
+    const auto half = plan.size() / 2 + 1;
+    filter.resize(half);
+    std::fill(filter.re.begin(), filter.re.end(), 0);
+    std::fill(filter.im.begin(), filter.im.end(), 0);
+    for (size_t i = 0; i < std::min(signal.size(), plan.size()); ++i)
+        (i & 1u ? filter.im : filter.re)[i / 2] = signal[i];
+    plan.forward(filter.re.data(), filter.im.data());
+    filter.conjugate();
+}
+
+/**
+ * 互相关（动态部分），原地计算
+ * @remarks 频谱取自当前线程的临时内存区，稳定运行时不申请堆内存。
+ * @param filter 相关滤波器谱，来自 `xcorr_init`
+ * @param signal 原信号，前 min(n, signal.size()) 点被替换为相关结果
+ * @param plan 实变换计划
+ */
+inline void xcorr(split_complex_t const &filter, std::span<float> signal, rfft_plan_t const &plan) {
+    arena_scope_t scope;
+    
+    const auto half = plan.size() / 2 + 1,
+               n    = std::min(signal.size(), plan.size());
+    auto       re   = scope.allocate<float>(half),
+               im   = scope.allocate<float>(half);
+    std::fill(re.begin(), re.end(), 0);
+    std::fill(im.begin(), im.end(), 0);
+    for (size_t i = 0; i < n; ++i)
+        (i & 1u ? im : re)[i / 2] = signal[i];
+    plan.forward(re.data(), im.data());
+    
+    // 白化并乘以滤波器谱
+    for (size_t i = 0; i < half; ++i) {
+        const auto l2 = re[i] * re[i] + im[i] * im[i],
+                   k  = l2 == 0 ? 0 : 1 / std::sqrt(l2),
+                   r  = re[i] * k,
+                   j  = im[i] * k;
+        re[i] = r * filter.re[i] - j * filter.im[i];
+        im[i] = r * filter.im[i] + j * filter.re[i];
+    }
+    plan.inverse(re.data(), im.data());
+    
+    for (size_t i = 0; i < n; ++i)
+        signal[i] = (i & 1u ? im : re)[i / 2];
+}
+
+/**
+ * 用 FFT 变换实信号（运行时长度）
+ * @param signal 原信号
+ * @param size 变换长度
+ * @return 变换
+ */
+inline std::vector<complex_t> fft_real(std::vector<float> const &signal, size_t size) {
+    std::vector<complex_t> spectrum(size);
+    fft_real(signal, spectrum);
+    return spectrum;
+}
+
+namespace fft_real_detail {
+    /// 分组变换后合并，`transform` 对连续存放的各组完成 `_size_per_group` 点变换
+    template<auto _size_per_group, auto _group_count, class transform_t>
+    std::vector<complex_t> fft_real(std::vector<float> const &signal, transform_t const &transform) {
+        constexpr static auto _size = _group_count * _size_per_group;
+        static_assert(_group_count > 0);
+        
+        std::vector<complex_t> spectrum;
+        
+        if constexpr (_group_count == 1 && _size % 2 == 0) {
+            // 由半谱按共轭对称补全
+            spectrum = rfft<_size>(signal);
+            spectrum.resize(_size);
+            for (size_t i = _size / 2 + 1; i < _size; ++i)
+                spectrum[i] = spectrum[_size - i].conjugate();
+        } else if constexpr (_group_count == 1) {
+            spectrum.resize(_size, complex_t::zero);
+            std::transform(signal.begin(), signal.end(), spectrum.begin(),
+                           [](float z) -> complex_t { return {z, 0}; });
+            fft<_size>(spectrum.data());
+        } else {
+            spectrum.resize(_size, complex_t::zero);
+            
+            // 分组存放在临时内存区，不占用栈空间
+            arena_scope_t scope;
+            auto          memory = scope.allocate<complex_t>(_size);
+            std::fill(memory.begin(), memory.end(), complex_t::zero);
+            complex_t *parts[_group_count];
+            for (size_t i = 0; i < _group_count; ++i)
+                parts[i] = memory.data() + i * _size_per_group;
+            
+            { // 分组
+                complex_t *iterators[_group_count];
+                
+                for (size_t i = 0; i < _group_count; ++i)
+                    iterators[i] = parts[i];
+                
+                for (auto ptr = signal.begin(); ptr < signal.end();)
+                    for (auto &it : iterators) *it++ = {*ptr++, 0};
+            }
+            
+            // 变换
+            transform(memory.data());
+            
+            // 合并
+            auto const &plan = fft_plan<_size>::instance();
+            for (size_t i    = 0; i < _group_count; ++i)
+                for (size_t j = 0; j < _size_per_group; ++j) {
+                    auto n = i * _size_per_group + j;
+                    spectrum[n] = parts[0][j];
+                    for (size_t k = 1; k < _group_count; ++k)
+                        spectrum[n] += plan.omega(n * k) * parts[k][j];
+                }
+        }
+        
+        return spectrum;
+    }
+}
+
+/**
+ * 用 FFT 变换实信号
+ * @tparam _size_per_group 每组 FFT 长度
+ * @tparam _group_count FFT 分组数量
+ * @param signal 原信号
+ * @return 变换
+ */
+template<auto _size_per_group, auto _group_count = 1>
+std::vector<complex_t> fft_real(std::vector<float> const &signal) {
+    return fft_real_detail::fft_real<_size_per_group, _group_count>(signal, [](complex_t *memory) {
+        for (size_t i = 0; i < _group_count; ++i)
+            fft<_size_per_group>(memory + i * _size_per_group);
+    });
+}
+
+/**
+ * 用 FFT 变换实信号，各组变换在线程池上并行
+ * @tparam _size_per_group 每组 FFT 长度
+ * @tparam _group_count FFT 分组数量
+ * @param signal 原信号
+ * @param pool 线程池
+ * @return 变换
+ */
+template<auto _size_per_group, auto _group_count = 1>
+std::vector<complex_t> fft_real(std::vector<float> const &signal, thread_pool_t &pool) {
+    return fft_real_detail::fft_real<_size_per_group, _group_count>(signal, [&pool](complex_t *memory) {
+        fft_batch(memory, _size_per_group, _group_count, pool);
+    });
+}
+
+namespace resample_detail {
+    /// 频域补 0 升采样后抽取，`inverse` 完成升采样频谱的反变换
+    template<class inverse_t>
+    void resample(
+        std::span<float const> signal,
+        std::span<float> target,
+        float f0,
+        float f1,
+        size_t times,
+        size_t size0,
+        inverse_t const &inverse
+    ) {
+        arena_scope_t scope;
+        
+        auto n_downsampling = static_cast<size_t>(std::lroundf(f0 * times / f1));
+        auto enlarged       = scope.allocate<complex_t>(times * size0);
+        std::fill(enlarged.begin() + size0, enlarged.end(), complex_t::zero);
+        fft_real(signal, enlarged.first(size0));
+        
+        for (auto p = enlarged.begin() + size0 / 2, q = enlarged.end() - size0 / 2; q < enlarged.end(); ++p, ++q)
+            std::swap(*p, *q);
+        inverse(enlarged.data(), enlarged.size());
+        
+        std::fill(target.begin(), target.end(), 0);
+        for (size_t i = 0; i < target.size(); ++i) {
+            auto j = n_downsampling * i;
+            if (j >= enlarged.size()) break;
+            target[i] = enlarged[j].re;
+        }
+    }
+}
+
+/**
+ * 重采样，写入调用方提供的存储
+ * @remarks 与 `resample` 相同，升采样频谱取自当前线程的临时内存区。
+ * @param signal 原信号
+ * @param target 新信号，长度即新信号长度（点数不够将补 0）
+ * @param f0 原采样率
+ * @param f1 新采样率
+ * @param times 处理倍率
+ * @param size0 原信号变换长度
+ */
+inline void resample(
+    std::span<float const> signal,
+    std::span<float> target,
+    float f0,
+    float f1,
+    size_t times,
+    size_t size0
+) {
+    resample_detail::resample(signal, target, f0, f1, times, size0, [](complex_t *memory, size_t n) {
+        ifft(memory, n);
+    });
+}
+
+/**
+ * 重采样，升采样后的大点数反变换以四步法在线程池上并行
+ * @param signal 原信号
+ * @param target 新信号，长度即新信号长度（点数不够将补 0）
+ * @param f0 原采样率
+ * @param f1 新采样率
+ * @param times 处理倍率
+ * @param size0 原信号变换长度
+ * @param pool 线程池
+ */
+inline void resample(
+    std::span<float const> signal,
+    std::span<float> target,
+    float f0,
+    float f1,
+    size_t times,
+    size_t size0,
+    thread_pool_t &pool
+) {
+    resample_detail::resample(signal, target, f0, f1, times, size0, [&pool](complex_t *memory, size_t n) {
+        ifft(memory, n, pool);
+    });
+}
+
+/**
+ * 重采样（运行时长度）
+ * @param signal 原信号
+ * @param f0 原采样率
+ * @param f1 新采样率
+ * @param times 处理倍率
+ * @param size0 原信号长度（确保 `signal.size() < size0`）
+ * @param size1 新信号长度（点数不够将补 0）
+ * @return 重采样信号
+ */
+inline std::vector<float> resample(
+    std::vector<float> const &signal,
+    float f0,
+    float f1,
+    size_t times,
+    size_t size0,
+    size_t size1
+) {
+    auto target = std::vector<float>(size1, 0);
+    resample(signal, target, f0, f1, times, size0);
+    return target;
+}
+
+/**
+ * 重采样（运行时长度），升采样后的大点数反变换以四步法在线程池上并行
+ * @param signal 原信号
+ * @param f0 原采样率
+ * @param f1 新采样率
+ * @param times 处理倍率
+ * @param size0 原信号长度（确保 `signal.size() < size0`）
+ * @param size1 新信号长度（点数不够将补 0）
+ * @param pool 线程池
+ * @return 重采样信号
+ */
+inline std::vector<float> resample(
+    std::vector<float> const &signal,
+    float f0,
+    float f1,
+    size_t times,
+    size_t size0,
+    size_t size1,
+    thread_pool_t &pool
+) {
+    auto target = std::vector<float>(size1, 0);
+    resample(signal, target, f0, f1, times, size0, pool);
+    return target;
+}
+
 /**
  * 重采样
  * @remarks 重采样用于把某一采样率的信号用新的采样率重新采样，可以进行升采样，也可以进行降采样。
  *          重采样的原理是先大倍数升采样，再在近似新采样率下抽取，
  *          因此，仅当新采样率与原采样率有整倍数关系，重采样才保证准确性。
  *          否则，倍率越大，采样越准。
+ *          此实现作为参考路径保留；流式处理或大倍率时使用 resampler.h 中的多相重采样器。
  * @tparam times 处理倍率
  * @tparam size0 原信号长度（确保 `signal.size() < size0`）
  * @tparam size1 新信号长度（点数不够将补 0）
@@ -70,72 +595,54 @@ std::vector<float> resample(
     float f0,
     float f1
 ) {
-    auto n_downsampling = std::lroundf(f0 * times / f1);
-    auto enlarged       = fft_real<size0>(signal);
-    enlarged.resize(times * size0);
-    
-    for (auto p = enlarged.begin() + size0 / 2, q = enlarged.end() - size0 / 2; q < enlarged.end(); ++p, ++q) {
-        auto temp = *p;
-        *p = *q;
-        *q = temp;
-    }
-    ifft<times * size0>(enlarged.data());
-    
-    auto      target = std::vector<float>(size1, 0);
-    for (auto i      = 0; i < size1; ++i) {
-        auto j = n_downsampling * i;
-        if (j >= enlarged.size()) break;
-        target[i] = enlarged[j].re;
-    }
-    return target;
+    return resample(signal, f0, f1, times, size0, size1);
 }
 
 /**
- * 用 FFT 变换实信号
- * @tparam _size_per_group 每组 FFT 长度，必须是 2 的整数次幂
- * @tparam _group_count FFT 分组数量
+ * 重采样，升采样后的 `times·size0` 点反变换以四步法在线程池上并行
+ * @tparam times 处理倍率
+ * @tparam size0 原信号长度（确保 `signal.size() < size0`）
+ * @tparam size1 新信号长度（点数不够将补 0）
  * @param signal 原信号
- * @return 变换
+ * @param f0 原采样率
+ * @param f1 新采样率
+ * @param pool 线程池
+ * @return 重采样信号
  */
-template<auto _size_per_group, auto _group_count = 1>
-std::vector<complex_t> fft_real(std::vector<float> const &signal) {
-    constexpr static auto _size = _group_count * _size_per_group;
-    static_assert(_group_count > 0);
-    static_assert(check_power_2<_size>(), "size is not power of 2");
-    
-    std::vector<complex_t> spectrum(_size, complex_t::zero);
-    
-    if constexpr (_group_count == 1) {
-        std::transform(signal.begin(), signal.end(), spectrum.begin(),
-                       [](float z) -> complex_t { return {z, 0}; });
-        fft<_size_per_group>(spectrum.data());
-    } else {
-        complex_t parts[_group_count][_size_per_group]{{}};
-        
-        { // 分组
-            complex_t *iterators[_group_count];
-            
-            for (size_t i = 0; i < _group_count; ++i)
-                iterators[i] = parts[i];
-            
-            for (auto ptr = signal.begin(); ptr < signal.end();)
-                for (auto &it : iterators) *it++ = {*ptr++, 0};
-        }
-        
-        // 变换
-        for (auto v : parts) fft<decltype(_size_per_group), _size_per_group>(v);
-        
-        // 合并
-        for (size_t i = 0; i < _group_count; ++i)
-            for (size_t j = 0; j < _size_per_group; ++j) {
-                auto n = i * _size_per_group + j;
-                spectrum[n] = parts[0][j];
-                for (size_t k = 1; k < _group_count; ++k)
-                    spectrum[n] += omega<_size>(n * k) * parts[k][j];
-            }
-    }
-    
-    return spectrum;
+template<auto times, auto size0, auto size1>
+std::vector<float> resample(
+    std::vector<float> const &signal,
+    float f0,
+    float f1,
+    thread_pool_t &pool
+) {
+    return resample(signal, f0, f1, times, size0, size1, pool);
+}
+
+/**
+ * 快速卷积
+ * @param a 信号a
+ * @param b 信号b
+ * @param plan 实变换计划，决定计算长度
+ * @return 卷积信号
+ */
+inline std::vector<float> convolve(
+    std::vector<float> const &a,
+    std::vector<float> const &b,
+    rfft_plan_t const &plan
+) {
+    std::vector<float> result(plan.size());
+    convolve(a, b, result, plan);
+    return result;
+}
+
+/// 快速卷积（运行时长度，必须是偶数）
+inline std::vector<float> convolve(
+    std::vector<float> const &a,
+    std::vector<float> const &b,
+    size_t size
+) {
+    return convolve(a, b, cached_plan<rfft_plan_t>(size));
 }
 
 /**
@@ -150,57 +657,55 @@ std::vector<float> convolve(
     std::vector<float> const &a,
     std::vector<float> const &b
 ) {
-    static_assert(check_power_2<_size>(), "size is not power of 2");
-    
-    auto      fa = fft_real<_size>(a),
-              fb = fft_real<_size>(b);
-    for (auto p  = fa.begin(),
-              q  = fb.begin();
-         p < fa.end(); ++p, ++q)
-        *p *= *q;
-    ifft<_size>(fa.data());
+    static_assert(_size % 2 == 0, "size is not even");
     
-    std::vector<float> result(_size);
-    std::transform(fa.begin(), fa.end(), result.begin(),
-                   [](complex_t z) { return z.re; });
+    return convolve(a, b, rfft_plan<_size>::instance());
+}
+
+/// 希尔伯特变换
+inline std::vector<complex_t> hilbert(std::vector<float> const &x, rfft_plan_t const &plan) {
+    std::vector<complex_t> result(x.size());
+    hilbert(x, result, plan);
     return result;
 }
 
+/// 希尔伯特变换（运行时长度，必须是偶数）
+inline std::vector<complex_t> hilbert(std::vector<float> const &x, size_t size) {
+    return hilbert(x, cached_plan<rfft_plan_t>(size));
+}
+
 /// 希尔伯特变换
 template<auto _size>
 std::vector<complex_t> hilbert(std::vector<float> const &x) {
-    static_assert(check_power_2<_size>(), "size is not power of 2");
-    
-    // 生成超前 90° 的信号（虚部）
-    auto result = fft_real<_size>(x);
-    {
-        auto p = result.begin();
-        ++p; // 避开 0 频率点，前一半，正频率部分，超前 90°
-        while (p < result.begin() + _size / 2)
-            *p++ = {p->im, -p->re};
-        ++p; // 避开 0 频率点，后一半，负频率部分，滞后 90°
-        while (p < result.end())
-            *p++ = {-p->im, p->re};
-    }
-    ifft<_size>(result.data());
+    static_assert(_size % 2 == 0, "size is not even");
     
-    // 与原信号合并为复信号
-    result.resize(x.size());
-    auto p = x.begin();
-    auto q = result.begin();
-    while (p < x.end()) *q++ = {*p++, q->re};
-    return result;
+    return hilbert(x, rfft_plan<_size>::instance());
 }
 
 /**
  * 互相关（静态部分）=== 傅里叶变换并取共轭
- * @tparam _size 变换长度，必须是 2 的整数次幂
  * @param signal 原信号
- * @return 相关滤波器谱
+ * @param plan 实变换计划
+ * @return 相关滤波器谱（非负频率部分，共 `n / 2 + 1` 点）
+ */
+inline split_complex_t xcorr_init(std::vector<float> const &signal, rfft_plan_t const &plan) {
+    return rfft_split(signal, plan).conjugate();
+}
+
+/// 互相关（静态部分）（运行时长度，必须是偶数）
+inline split_complex_t xcorr_init(std::vector<float> const &signal, size_t size) {
+    return xcorr_init(signal, cached_plan<rfft_plan_t>(size));
+}
+
+/**
+ * 互相关（静态部分）=== 傅里叶变换并取共轭
+ * @tparam _size 变换长度，必须是偶数
+ * @param signal 原信号
+ * @return 相关滤波器谱（完整的 `_size` 点，交错存储）
  */
 template<auto _size>
 std::vector<complex_t> xcorr_init(std::vector<float> const &signal) {
-    static_assert(check_power_2<_size>(), "size is not power of 2");
+    static_assert(_size % 2 == 0, "size is not even");
     
     auto spectrum = fft_real<_size>(signal);
     
@@ -209,23 +714,207 @@ std::vector<complex_t> xcorr_init(std::vector<float> const &signal) {
     return spectrum;
 }
 
+/**
+ * 互相关（静态部分）=== 傅里叶变换并取共轭，分离存储
+ * @tparam _size 变换长度，必须是偶数
+ * @param signal 原信号
+ * @return 相关滤波器谱（非负频率部分，共 `_size / 2 + 1` 点）
+ */
+template<auto _size>
+split_complex_t xcorr_init_split(std::vector<float> const &signal) {
+    static_assert(_size % 2 == 0, "size is not even");
+    
+    return xcorr_init(signal, rfft_plan<_size>::instance());
+}
+
 /**
  * 互相关（动态部分）=== 白化并乘以滤波器谱
- * @tparam _size 变换长度，必须是 2 的整数次幂
+ * @param filter 相关滤波器谱，来自 `xcorr_init`
+ * @param signal 原信号
+ * @param plan 实变换计划
+ */
+inline void xcorr(split_complex_t const &filter, std::vector<float> &signal, rfft_plan_t const &plan) {
+    xcorr(filter, std::span<float>(signal), plan);
+}
+
+/// 互相关（动态部分）（运行时长度，必须是偶数）
+inline void xcorr(split_complex_t const &filter, std::vector<float> &signal, size_t size) {
+    xcorr(filter, signal, cached_plan<rfft_plan_t>(size));
+}
+
+/**
+ * 互相关（动态部分）=== 白化并乘以滤波器谱
+ * @tparam _size 变换长度，必须是偶数
  * @param filter 相关滤波器谱，来自 `xcorr_init`
  * @param signal 原信号
  */
 template<auto _size>
+void xcorr(split_complex_t const &filter, std::vector<float> &signal) {
+    static_assert(_size % 2 == 0, "size is not even");
+    
+    xcorr(filter, signal, rfft_plan<_size>::instance());
+}
+
+/// 互相关（动态部分），滤波器谱交错存储（来自 `xcorr_init<_size>`，只用到非负频率部分）
+template<auto _size>
 void xcorr(std::vector<complex_t> const &filter, std::vector<float> &signal) {
-    static_assert(check_power_2<_size>(), "size is not power of 2");
+    xcorr<_size>(split_complex_t(filter), signal);
+}
+
+/**
+ * 互相关（静态部分），一组参考信号
+ * @param signals 参考信号
+ * @param plan 实变换计划
+ * @return 各参考信号的相关滤波器谱
+ */
+inline std::vector<split_complex_t> xcorr_init(
+    std::vector<std::vector<float>> const &signals,
+    rfft_plan_t const &plan
+) {
+    std::vector<split_complex_t> filters;
+    filters.reserve(signals.size());
+    for (auto const &signal : signals)
+        filters.push_back(xcorr_init(signal, plan));
+    return filters;
+}
+
+/// 互相关（静态部分），一组参考信号（运行时长度，必须是偶数）
+inline std::vector<split_complex_t> xcorr_init(
+    std::vector<std::vector<float>> const &signals,
+    size_t size
+) {
+    return xcorr_init(signals, cached_plan<rfft_plan_t>(size));
+}
+
+/**
+ * 互相关（静态部分），一组参考信号，分离存储
+ * @tparam _size 变换长度，必须是偶数
+ * @param signals 参考信号
+ * @return 各参考信号的相关滤波器谱
+ */
+template<auto _size>
+std::vector<split_complex_t> xcorr_init_split(std::vector<std::vector<float>> const &signals) {
+    static_assert(_size % 2 == 0, "size is not even");
     
-    auto spectrum = fft_real<_size>(signal);
-    auto p        = filter.begin();
-    auto q        = spectrum.begin();
-    while (p < filter.end()) *q++ = q->normalize() * *p++;
+    return xcorr_init(signals, rfft_plan<_size>::instance());
+}
+
+namespace xcorr_detail {
+    /// 一次正变换并白化，再由 `for_each(count, body)` 对每个参考信号调用 `body(r)` 做逐点乘和反变换
+    template<class for_each_t>
+    std::vector<std::vector<float>> xcorr(
+        std::vector<split_complex_t> const &filters,
+        std::vector<float> const &signal,
+        rfft_plan_t const &plan,
+        for_each_t const &for_each
+    ) {
+        arena_scope_t scope;
+        
+        const auto half = plan.size() / 2 + 1,
+                   n    = std::min(signal.size(), plan.size());
+        auto       sr   = scope.allocate<float>(half),
+                   si   = scope.allocate<float>(half);
+        
+        // 一次正变换并白化
+        std::fill(sr.begin(), sr.end(), 0);
+        std::fill(si.begin(), si.end(), 0);
+        for (size_t i = 0; i < n; ++i)
+            (i & 1u ? si : sr)[i / 2] = signal[i];
+        plan.forward(sr.data(), si.data());
+        for (size_t i = 0; i < half; ++i) {
+            const auto l2 = sr[i] * sr[i] + si[i] * si[i],
+                       k  = l2 == 0 ? 0 : 1 / std::sqrt(l2);
+            sr[i] *= k;
+            si[i] *= k;
+        }
+        
+        // 每个参考信号：乘积直接写入执行线程的工作区，再反变换
+        std::vector<std::vector<float>> result(filters.size(), std::vector<float>(plan.size()));
+        for_each(filters.size(), [&](size_t r) {
+            arena_scope_t local;
+            
+            auto       pr = local.allocate<float>(half),
+                       pi = local.allocate<float>(half);
+            auto const *fr = filters[r].re.data(),
+                       *fi = filters[r].im.data();
+            for (size_t i = 0; i < half; ++i) {
+                pr[i] = sr[i] * fr[i] - si[i] * fi[i];
+                pi[i] = sr[i] * fi[i] + si[i] * fr[i];
+            }
+            plan.inverse(pr.data(), pi.data());
+            
+            auto &y = result[r];
+            for (size_t i = 0; i < y.size(); ++i)
+                y[i] = (i & 1u ? pi : pr)[i / 2];
+        });
+        return result;
+    }
+}
+
+/**
+ * 互相关（动态部分），同一信号与一组参考信号批量相关
+ * @remarks 信号只做一次正变换和白化，之后每个参考信号只需一次逐点乘和一次反变换。
+ *          白化谱与乘积都放在临时内存区，逐点乘直接从白化谱和滤波器谱写入乘积，
+ *          不再逐个参考信号复制白化谱；白化谱在整个批次中保持在缓存里。
+ * @param filters 相关滤波器谱，来自 `xcorr_init`
+ * @param signal 原信号
+ * @param plan 实变换计划
+ * @return 与每个参考信号的相关结果
+ */
+inline std::vector<std::vector<float>> xcorr(
+    std::vector<split_complex_t> const &filters,
+    std::vector<float> const &signal,
+    rfft_plan_t const &plan
+) {
+    return xcorr_detail::xcorr(filters, signal, plan, [](size_t count, auto const &body) {
+        for (size_t r = 0; r < count; ++r) body(r);
+    });
+}
+
+/**
+ * 互相关（动态部分），同一信号与一组参考信号批量相关，各参考信号的反变换在线程池上并行
+ * @remarks 正变换和白化只做一次，由调用线程完成；白化谱只读共享，每个工作线程的乘积放在自己的临时内存区。
+ * @param filters 相关滤波器谱，来自 `xcorr_init`
+ * @param signal 原信号
+ * @param plan 实变换计划
+ * @param pool 线程池
+ * @return 与每个参考信号的相关结果
+ */
+inline std::vector<std::vector<float>> xcorr(
+    std::vector<split_complex_t> const &filters,
+    std::vector<float> const &signal,
+    rfft_plan_t const &plan,
+    thread_pool_t &pool
+) {
+    return xcorr_detail::xcorr(filters, signal, plan, [&pool](size_t count, auto const &body) {
+        pool.parallel_for(count, [&](size_t r, size_t) { body(r); });
+    });
+}
+
+/// 互相关（动态部分），批量（运行时长度，必须是偶数）
+inline std::vector<std::vector<float>> xcorr(
+    std::vector<split_complex_t> const &filters,
+    std::vector<float> const &signal,
+    size_t size
+) {
+    return xcorr(filters, signal, cached_plan<rfft_plan_t>(size));
+}
+
+/**
+ * 互相关（动态部分），同一信号与一组参考信号批量相关
+ * @tparam _size 变换长度，必须是偶数
+ * @param filters 相关滤波器谱，来自 `xcorr_init`
+ * @param signal 原信号
+ * @return 与每个参考信号的相关结果
+ */
+template<auto _size>
+std::vector<std::vector<float>> xcorr(
+    std::vector<split_complex_t> const &filters,
+    std::vector<float> const &signal
+) {
+    static_assert(_size % 2 == 0, "size is not even");
     
-    ifft<_size>(spectrum.data());
-    std::transform(spectrum.begin(), spectrum.end(), signal.begin(), [](complex_t it) { return it.re; });
+    return xcorr(filters, signal, rfft_plan<_size>::instance());
 }
 
 #endif // SIMULATION_SIGNAL_PROCESS_H
@@ -0,0 +1,197 @@
+#ifndef SIMULATION_SIGNAL_READER_H
+#define SIMULATION_SIGNAL_READER_H
+
+#include <deque>
+#include <cctype>
+#include <algorithm>
+#include <type_traits>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <stdexcept>
+#include <condition_variable>
+
+#include "signal_file.h"
+
+/**
+ * 分块流式信号读取器
+ * @remarks 支持二进制信号文件和文本文件（数字间以空白或逗号分隔）。
+ *          后台线程预读至多 `depth` 块，调用方取走一块后才继续读，内存占用有界，
+ *          因此可以把任意长的录音逐块送入相关器而无需整体载入。输出统一转换为 float。
+ */
+class signal_reader_t {
+    std::FILE                      *_file;
+    signal_header_t                _header;
+    bool                           _binary;
+    size_t                         _block, _depth, _channel;
+    std::deque<std::vector<float>> _queue;
+    std::vector<std::vector<float>> _free;
+    bool                           _end, _stop;
+    std::mutex                     _mutex;
+    std::condition_variable        _signal;
+    std::thread                    _thread;
+    
+    // 只由后台线程使用的读缓冲
+    std::vector<char> _raw;
+    size_t            _position, _size;
+    std::string       _token;
+    
+    template<class sample_t>
+    static float to_float(sample_t x) {
+        if constexpr (std::is_same_v<sample_t, complex_t>)
+            return x.re;
+        else
+            return static_cast<float>(x);
+    }
+    
+    template<class sample_t>
+    size_t read_binary(std::vector<float> &chunk) {
+        const auto frame = sizeof(sample_t) * _header.channels;
+        _raw.resize(_block * frame);
+        
+        const auto n = std::fread(_raw.data(), frame, _block, _file);
+        chunk.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            sample_t x;
+            std::memcpy(&x, _raw.data() + i * frame + _channel * sizeof(sample_t), sizeof x);
+            chunk[i] = to_float(x);
+        }
+        return n;
+    }
+    
+    int get() {
+        if (_position == _size) {
+            _raw.resize(1u << 16u);
+            _size     = std::fread(_raw.data(), 1, _raw.size(), _file);
+            _position = 0;
+            if (_size == 0) return EOF;
+        }
+        return static_cast<unsigned char>(_raw[_position++]);
+    }
+    
+    size_t read_text(std::vector<float> &chunk) {
+        chunk.clear();
+        while (chunk.size() < _block) {
+            const auto c = get();
+            if (c == EOF || std::isspace(c) || c == ',') {
+                if (!_token.empty()) {
+                    chunk.push_back(std::strtof(_token.c_str(), nullptr));
+                    _token.clear();
+                }
+                if (c == EOF) break;
+            } else
+                _token.push_back(static_cast<char>(c));
+        }
+        return chunk.size();
+    }
+    
+    size_t read(std::vector<float> &chunk) {
+        if (!_binary) return read_text(chunk);
+        switch (_header.type) {
+            case sample_type_t::f32:
+                return read_binary<float>(chunk);
+            case sample_type_t::f64:
+                return read_binary<double>(chunk);
+            case sample_type_t::i16:
+                return read_binary<int16_t>(chunk);
+            case sample_type_t::u16:
+                return read_binary<uint16_t>(chunk);
+            case sample_type_t::c32:
+                return read_binary<complex_t>(chunk);
+        }
+        return 0;
+    }
+    
+    void work() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _signal.wait(lock, [this] { return _stop || _queue.size() < _depth; });
+            if (_stop) return;
+            
+            std::vector<float> chunk;
+            if (!_free.empty()) {
+                chunk = std::move(_free.back());
+                _free.pop_back();
+            }
+            lock.unlock();
+            chunk.reserve(_block);
+            const auto n = read(chunk);
+            lock.lock();
+            
+            if (n) _queue.push_back(std::move(chunk));
+            if (n < _block) _end = true;
+            _signal.notify_all();
+            if (_end) return;
+        }
+    }
+
+public:
+    /**
+     * 打开信号文件
+     * @param file_name 文件名；以 "SIGF" 开头的按二进制信号文件读取，否则按文本读取
+     * @param block 每块点数
+     * @param depth 预读块数
+     * @param channel 多通道二进制文件中要读取的通道
+     */
+    explicit signal_reader_t(std::string const &file_name, size_t block = 4096, size_t depth = 4, size_t channel = 0)
+        : _file(std::fopen(file_name.c_str(), "rb")), _binary(false),
+          _block(std::max<size_t>(block, 1)), _depth(std::max<size_t>(depth, 1)), _channel(channel),
+          _end(false), _stop(false), _position(0), _size(0) {
+        if (!_file) throw std::runtime_error("cannot open " + file_name);
+        
+        if (std::fread(&_header, sizeof _header, 1, _file) == 1 && _header.valid()) {
+            _binary = true;
+            if (_channel >= _header.channels) {
+                std::fclose(_file);
+                throw std::runtime_error("no such channel");
+            }
+        } else {
+            _header = {};
+            std::rewind(_file);
+        }
+        _thread = std::thread([this] { work(); });
+    }
+    
+    signal_reader_t(signal_reader_t const &) = delete;
+    
+    signal_reader_t &operator=(signal_reader_t const &) = delete;
+    
+    ~signal_reader_t() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _signal.notify_all();
+        _thread.join();
+        std::fclose(_file);
+    }
+    
+    /// 文件头（文本文件为默认值）
+    [[nodiscard]]
+    signal_header_t const &header() const {
+        return _header;
+    }
+    
+    /**
+     * 取下一块
+     * @param chunk 输出，至多 `block` 个点；原有内容被替换，其存储交还读取器复用
+     * @return 是否取到数据，false 表示已读完
+     */
+    bool next(std::vector<float> &chunk) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _signal.wait(lock, [this] { return !_queue.empty() || _end; });
+        if (_queue.empty()) return false;
+        
+        if (chunk.capacity()) _free.push_back(std::move(chunk));
+        chunk = std::move(_queue.front());
+        _queue.pop_front();
+        _signal.notify_all();
+        return true;
+    }
+};
+
+#endif // SIMULATION_SIGNAL_READER_H
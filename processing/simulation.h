@@ -12,15 +12,17 @@
 #include <functional>
 #include <algorithm>
 #include <numeric>
+#include <cstdlib>
+#include <stdexcept>
 
 #include "../signal/complex_t.hpp"
 #include "signal_process.h"
 
 #define SAVE_SIGNAL(PATH, S) \
-save_signal(PATH, S, [](std::ofstream &file, typename decltype(S)::value_type x) { file << x << std::endl; })
+save_signal(PATH, S, [](std::ofstream &file, typename decltype(S)::value_type x) { file << x << '\n'; })
 
 #define SAVE_SIGNAL_TF(PATH, S, TF) \
-save_signal(PATH, S, [](std::ofstream &file, typename decltype(S)::value_type x) { file << (TF) << std::endl; })
+save_signal(PATH, S, [](std::ofstream &file, typename decltype(S)::value_type x) { file << (TF) << '\n'; })
 
 #define SAVE_SIGNAL_FORMAT(PATH, S, TF) \
 save_signal(PATH, S, [](std::ofstream &file, typename decltype(S)::value_type x) { file << TF; })
@@ -72,16 +74,37 @@ std::vector<sample_t> load_signal(
     std::ifstream         file(file_name);
     sample_t              value;
     
+    if (!file) throw std::runtime_error("cannot open " + file_name);
+    
     for (auto p = signal.begin(); p < signal.end() && function(file, value); ++p)
         *p = value;
     return signal;
 }
 
+/**
+ * 发射端冲激响应文件路径
+ * @remarks 取自环境变量 `TRANSDUCER_RESPONSE`，未设置时抛出异常。
+ * @return 文件路径
+ */
+inline std::string transducer_response_path() {
+    const auto path = std::getenv("TRANSDUCER_RESPONSE");
+    if (!path || !*path)
+        throw std::runtime_error("TRANSDUCER_RESPONSE is not set; it must name the transducer impulse response file");
+    return path;
+}
+
+/**
+ * 计算发射信号
+ * @tparam _size 卷积计算长度
+ * @param x0 激励信号
+ * @param path 发射端冲激响应文件（2048 点，1 MHz），如 `transducer_response_path()`；无法打开时抛出异常
+ * @return 发射信号
+ */
 template<auto _size>
-std::vector<float> send_signal(std::vector<float> const &x0) {
+std::vector<float> send_signal(std::vector<float> const &x0, std::string const &path) {
     // 加载发射端冲激响应原始数据
     auto t0 = load_signal<float, 2048>(
-        "C:\\Users\\ydrml\\Desktop\\数据\\2048_1M.txt",
+        path,
         [](std::ifstream &file, float &value) {
             return (bool) (file >> value);
         });
@@ -16,4 +16,9 @@ constexpr bool check_power_2() {
     return !value || k == 1;
 }
 
+/// 运行时检查 2 的整数次幂
+constexpr bool check_power_2(unsigned long long value) {
+    return value && !(value & (value - 1));
+}
+
 #endif //SIMULATION_STATIC_CHECK_H
@@ -0,0 +1,159 @@
+#ifndef SIMULATION_STREAM_CORRELATOR_H
+#define SIMULATION_STREAM_CORRELATOR_H
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+
+#include "../signal/split_complex_t.hpp"
+#include "fft.h"
+
+/**
+ * 流式互相关器（匹配滤波）
+ * @remarks 保存一个或多个参考信号的共轭谱，按重叠保留法连续计算 c[n] = Σ x[n+k]·r[k]。
+ *          每帧 N 点中保留上一帧末尾 L-1 点，跨帧边界的相关峰不会丢失；
+ *          每凑满 B = N - L + 1 个新输入点输出 B 个相关值。
+ *          与 `xcorr` 相同，默认对每帧输入谱做 PHAT 白化。
+ */
+class stream_correlator_t {
+    size_t                       _length, _block;
+    rfft_plan_t const            *_plan;
+    std::vector<split_complex_t> _filters;
+    split_complex_t              _spectrum, _product;
+    std::vector<float>           _frame;
+    size_t                       _fill;
+    bool                         _phat;
+    
+    /// 变换当前帧并为每个参考信号输出 B 个相关值
+    void run(std::vector<std::vector<float>> &outputs) {
+        const auto half = _plan->size() / 2;
+        
+        for (size_t i = 0; i < half; ++i) {
+            _spectrum.re[i] = _frame[2 * i];
+            _spectrum.im[i] = _frame[2 * i + 1];
+        }
+        _plan->forward(_spectrum.re.data(), _spectrum.im.data());
+        if (_phat) _spectrum.normalize();
+        
+        outputs.resize(_filters.size());
+        for (size_t r = 0; r < _filters.size(); ++r) {
+            // 乘积直接写入反变换工作区，不再逐个参考信号复制输入谱
+            _product.multiply(_spectrum, _filters[r]);
+            _plan->inverse(_product.re.data(), _product.im.data());
+            
+            auto &output = outputs[r];
+            for (size_t i = 0; i < _block; ++i)
+                output.push_back(i & 1u ? _product.im[i / 2] : _product.re[i / 2]);
+        }
+        
+        // 保留最后 L-1 个输入点，它们对应的相关值尚未输出
+        std::copy(_frame.end() - (_length - 1), _frame.end(), _frame.begin());
+        _fill = _length - 1;
+    }
+
+public:
+    /**
+     * 构造互相关器
+     * @param references 参考信号，长度可以不同
+     * @param fft_size 变换长度，必须是偶数（由 `rfft_plan_t` 检查）且不小于最长参考信号，否则抛出 `std::invalid_argument`；
+     *                 为 0 时取不小于其 2 倍的 2 的整数次幂
+     * @param phat 是否做 PHAT 白化
+     */
+    explicit stream_correlator_t(std::vector<std::vector<float>> const &references,
+                                 size_t fft_size = 0,
+                                 bool phat = true)
+        : _length(1), _fill(0), _phat(phat) {
+        for (auto const &reference : references)
+            _length = std::max(_length, reference.size());
+        if (fft_size == 0) {
+            fft_size = 2;
+            while (fft_size < 2 * _length) fft_size <<= 1u;
+        }
+        if (fft_size < _length) throw std::invalid_argument("fft size must not be less than reference length");
+        _block = fft_size - _length + 1;
+        _plan  = &cached_plan<rfft_plan_t>(fft_size);
+        
+        _spectrum = split_complex_t(fft_size / 2 + 1);
+        _product  = split_complex_t(fft_size / 2 + 1);
+        _frame.assign(fft_size, 0);
+        
+        _filters.reserve(references.size());
+        for (auto const &reference : references) {
+            split_complex_t filter(fft_size / 2 + 1);
+            for (size_t i = 0; i < reference.size(); ++i)
+                (i & 1u ? filter.im : filter.re)[i / 2] = reference[i];
+            _plan->forward(filter.re.data(), filter.im.data());
+            filter.conjugate();
+            _filters.push_back(std::move(filter));
+        }
+    }
+    
+    /// 单个参考信号
+    explicit stream_correlator_t(std::vector<float> const &reference,
+                                 size_t fft_size = 0,
+                                 bool phat = true)
+        : stream_correlator_t(std::vector<std::vector<float>>{reference}, fft_size, phat) {}
+    
+    /// 清除历史输入，回到初始状态
+    void reset() {
+        std::fill(_frame.begin(), _frame.end(), 0);
+        _fill = 0;
+    }
+    
+    /// 参考信号数
+    [[nodiscard]]
+    size_t references() const {
+        return _filters.size();
+    }
+    
+    /// 每次变换产生的相关值个数
+    [[nodiscard]]
+    size_t block_size() const {
+        return _block;
+    }
+    
+    /**
+     * 送入一段输入
+     * @param input 输入
+     * @param length 输入长度，任意
+     * @param outputs 每个参考信号一路输出，产生的相关值追加到对应的一路
+     */
+    void process(float const *input, size_t length, std::vector<std::vector<float>> &outputs) {
+        while (length) {
+            const auto n = std::min(length, _frame.size() - _fill);
+            std::copy(input, input + n, _frame.begin() + _fill);
+            _fill += n;
+            input += n;
+            length -= n;
+            if (_fill == _frame.size()) run(outputs);
+        }
+    }
+    
+    /// 送入一段输入，返回这次产生的相关值
+    std::vector<std::vector<float>> process(std::vector<float> const &input) {
+        std::vector<std::vector<float>> outputs(_filters.size());
+        process(input.data(), input.size(), outputs);
+        return outputs;
+    }
+    
+    /**
+     * 以 0 补齐并输出已送入的所有输入点对应的剩余相关值
+     * @param outputs 每个参考信号一路输出
+     */
+    void flush(std::vector<std::vector<float>> &outputs) {
+        outputs.resize(_filters.size());
+        std::vector<size_t> sizes(outputs.size());
+        for (size_t r = 0; r < outputs.size(); ++r) sizes[r] = outputs[r].size();
+        
+        const auto remain = _fill;
+        for (size_t done = 0; done < remain; done += _block) {
+            std::fill(_frame.begin() + _fill, _frame.end(), 0);
+            run(outputs);
+        }
+        for (size_t r = 0; r < outputs.size(); ++r) outputs[r].resize(sizes[r] + remain);
+        reset();
+    }
+};
+
+#endif // SIMULATION_STREAM_CORRELATOR_H
@@ -0,0 +1,219 @@
+#ifndef SIMULATION_THREAD_POOL_H
+#define SIMULATION_THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <condition_variable>
+
+/**
+ * 工作窃取线程池
+ * @remarks 每个工作线程有自己的任务队列，从队尾取自己的任务，空闲时从其他队列的队首窃取，
+ *          任务粒度不均时负载也能自动均衡。任务收到执行它的工作线程序号，
+ *          可以据此使用按线程分配的缓冲区而无需加锁。
+ *          `parallel_for` 可以嵌套：在任务内调用时，调用它的工作线程自己也认领分块执行，
+ *          只等待本次调用的分块，不会因所有工作线程都在等待而死锁。
+ */
+class thread_pool_t {
+    using task_t = std::function<void(size_t)>;
+    
+    struct queue_t {
+        std::mutex         mutex;
+        std::deque<task_t> tasks;
+    };
+    
+    /// 一次 `parallel_for` 的共享状态，分块由调用线程和辅助任务按序认领
+    struct group_t {
+        size_t                              chunks;
+        std::function<void(size_t, size_t)> run;      // (分块序号, 工作线程序号)
+        std::atomic<size_t>                 next{0}, finished{0};
+        std::mutex                          mutex;
+        std::condition_variable             done;
+        std::exception_ptr                  error;
+        
+        /// 认领并执行分块直到取完，异常只保留第一个
+        void help(size_t worker) {
+            for (size_t k; (k = next++) < chunks;) {
+                try {
+                    run(k, worker);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) error = std::current_exception();
+                }
+                if (++finished == chunks) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done.notify_all();
+                }
+            }
+        }
+    };
+    
+    /// 当前线程所属的线程池及其序号，不是工作线程时线程池为空
+    struct worker_t {
+        thread_pool_t const *pool;
+        size_t              index;
+    };
+    
+    static worker_t &current() {
+        thread_local worker_t worker{nullptr, 0};
+        return worker;
+    }
+    
+    std::vector<std::unique_ptr<queue_t>> _queues;
+    std::vector<std::thread>              _threads;
+    std::mutex                            _mutex;
+    std::condition_variable               _wake, _done;
+    std::atomic<size_t>                   _queued, _pending, _next;
+    std::exception_ptr                    _error;
+    bool                                  _stop;
+    
+    bool pop(size_t i, task_t &task) {
+        auto                        &queue = *_queues[i];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        --_queued;
+        return true;
+    }
+    
+    bool steal(size_t i, task_t &task) {
+        for (size_t k = 1; k < _queues.size(); ++k) {
+            auto                        &queue = *_queues[(i + k) % _queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            --_queued;
+            return true;
+        }
+        return false;
+    }
+    
+    void work(size_t i) {
+        current() = {this, i};
+        
+        task_t task;
+        while (true) {
+            if (pop(i, task) || steal(i, task)) {
+                try {
+                    task(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_error) _error = std::current_exception();
+                }
+                if (--_pending == 0) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _done.notify_all();
+                }
+                continue;
+            }
+            
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this] { return _stop || _queued > 0; });
+            if (_stop && _queued == 0) return;
+        }
+    }
+
+public:
+    /**
+     * 构造线程池
+     * @param threads 工作线程数，为 0 时取硬件线程数
+     */
+    explicit thread_pool_t(size_t threads = 0)
+        : _queued(0), _pending(0), _next(0), _stop(false) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t i = 0; i < threads; ++i)
+            _queues.push_back(std::make_unique<queue_t>());
+        for (size_t i = 0; i < threads; ++i)
+            _threads.emplace_back([this, i] { work(i); });
+    }
+    
+    thread_pool_t(thread_pool_t const &) = delete;
+    
+    thread_pool_t &operator=(thread_pool_t const &) = delete;
+    
+    ~thread_pool_t() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto &thread : _threads) thread.join();
+    }
+    
+    /// 工作线程数
+    [[nodiscard]]
+    size_t size() const {
+        return _threads.size();
+    }
+    
+    /**
+     * 提交任务
+     * @param task 任务，参数为执行它的工作线程序号
+     */
+    void submit(task_t task) {
+        ++_pending;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_queued;
+        }
+        {
+            auto                        &queue = *_queues[_next++ % _queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        _wake.notify_one();
+    }
+    
+    /**
+     * 等待已提交的任务全部完成
+     * @remarks 等待的是整个线程池，不能在任务内调用；任务内需要并行时使用 `parallel_for`。
+     *          任务抛出的第一个异常在此重新抛出。
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _pending == 0; });
+        if (_error) std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+    
+    /**
+     * 并行执行 body(i, worker)，0 <= i < count，返回时全部完成
+     * @remarks 只等待本次调用的迭代，可以在任务内嵌套调用，此时当前工作线程也参与执行。
+     *          循环体抛出的第一个异常在所有迭代结束后重新抛出。
+     * @param count 迭代次数
+     * @param body 循环体
+     */
+    template<class body_t>
+    void parallel_for(size_t count, body_t const &body) {
+        if (count == 0) return;
+        
+        const auto chunk = std::max<size_t>(1, count / (8 * size()));
+        auto       group = std::make_shared<group_t>();
+        group->chunks = (count + chunk - 1) / chunk;
+        group->run    = [&body, count, chunk](size_t k, size_t worker) {
+            for (auto i = k * chunk, end = std::min(count, i + chunk); i < end; ++i) body(i, worker);
+        };
+        
+        // 辅助任务持有共享状态，晚于本次调用开始的辅助任务认领不到分块，直接返回
+        for (size_t i = 0, n = std::min(size(), group->chunks); i < n; ++i)
+            submit([group](size_t worker) { group->help(worker); });
+        if (auto const &self = current(); self.pool == this)
+            group->help(self.index);
+        
+        {
+            std::unique_lock<std::mutex> lock(group->mutex);
+            group->done.wait(lock, [&] { return group->finished == group->chunks; });
+        }
+        if (group->error) std::rethrow_exception(group->error);
+    }
+};
+
+#endif // SIMULATION_THREAD_POOL_H
@@ -0,0 +1,190 @@
+#ifndef SIMULATION_TOA_ESTIMATOR_H
+#define SIMULATION_TOA_ESTIMATOR_H
+
+#include <span>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+/**
+ * 到达时刻估计结果
+ * @param found 是否检测到到达
+ * @param index 到达时刻（相关输出的点序号，含亚采样点的小数部分）
+ * @param tof 飞行时间（秒）
+ * @param distance 距离（米）
+ * @param peak 到达峰的相关值（带符号）
+ * @param noise 噪底（相关输出的均方根，不含最大峰两侧各一个主瓣宽度）
+ */
+struct arrival_t {
+    bool  found;
+    float index;
+    float tof;
+    float distance;
+    float peak;
+    float noise;
+};
+
+/**
+ * 亚采样精度的到达时刻估计器
+ * @remarks 作用于 `xcorr` 或 `stream_correlator_t` 的相关输出：
+ *          1. 一次归约求平方和与最大峰（按 8 路分拆累加，便于编译器向量化），
+ *             扣除最大峰两侧各一个主瓣宽度内的能量后得到噪底，避免强峰的旁瓣抬高门限；
+ *          2. 门限取噪底的 `noise_factor` 倍与最大峰的 `relative` 倍中较大者，
+ *             从头扫描到第一个过门限的点即停止，取其后一个主瓣宽度内幅值最大的点作为首达峰。
+ *             窄带信号的相关主瓣内有多个载波周期，先过门限的往往不是主瓣顶点，故不能只找局部最大值；
+ *             多径的反射峰即使比直达峰更高，只要与直达峰相隔超过主瓣宽度，也不会被误认为首达；
+ *          3. 在首达峰附近以抛物线或加窗 sinc 插值求亚采样峰位。
+ */
+class toa_estimator_t {
+public:
+    /// 峰位插值方法
+    enum class interpolation_t {
+        parabolic, // 三点抛物线
+        sinc,      // 加窗 sinc 带限插值，在整数峰位两侧半个点内黄金分割搜索
+    };
+
+private:
+    constexpr static size_t lanes = 8, sinc_half = 8;
+    
+    float           _fs, _c, _noise_factor, _relative;
+    size_t          _lobe;
+    interpolation_t _interpolation;
+    
+    /// 以带符号相关值 `sign * x` 在 `t` 处做加窗 sinc 插值
+    static float sinc_at(std::span<float const> x, float sign, float t) {
+        constexpr auto pi = 3.14159265358979f;
+        
+        const auto center = static_cast<long>(std::floor(t));
+        float      sum    = 0;
+        for (auto i = center - static_cast<long>(sinc_half) + 1; i <= center + static_cast<long>(sinc_half); ++i) {
+            if (i < 0 || i >= static_cast<long>(x.size())) continue;
+            const auto d = t - static_cast<float>(i);
+            const auto s = std::abs(d) < 1e-6f ? 1 : std::sin(pi * d) / (pi * d);
+            const auto w = .5f + .5f * std::cos(pi * d / sinc_half); // 汉宁窗
+            sum += x[i] * s * w;
+        }
+        return sign * sum;
+    }
+    
+    /// 在整数峰位 `i` 附近求亚采样峰位
+    [[nodiscard]]
+    float refine(std::span<float const> x, size_t i, float sign) const {
+        if (i == 0 || i + 1 >= x.size()) return static_cast<float>(i);
+        
+        const auto y0 = sign * x[i - 1],
+                   y1 = sign * x[i],
+                   y2 = sign * x[i + 1],
+                   d  = y0 - 2 * y1 + y2;
+        if (_interpolation == interpolation_t::parabolic)
+            return static_cast<float>(i) + (d < 0 ? std::clamp(.5f * (y0 - y2) / d, -.5f, .5f) : 0);
+        
+        // 黄金分割搜索，区间为整数峰位两侧各半个点，15 次迭代精度约 1e-3 点
+        constexpr auto ratio = .618033988f;
+        
+        auto a  = static_cast<float>(i) - .5f,
+             b  = static_cast<float>(i) + .5f,
+             t1 = b - ratio * (b - a),
+             t2 = a + ratio * (b - a);
+        auto f1 = sinc_at(x, sign, t1),
+             f2 = sinc_at(x, sign, t2);
+        for (auto k = 0; k < 15; ++k) {
+            if (f1 < f2) {
+                a  = t1;
+                t1 = t2;
+                f1 = f2;
+                t2 = a + ratio * (b - a);
+                f2 = sinc_at(x, sign, t2);
+            } else {
+                b  = t2;
+                t2 = t1;
+                f2 = f1;
+                t1 = b - ratio * (b - a);
+                f1 = sinc_at(x, sign, t1);
+            }
+        }
+        return (a + b) / 2;
+    }
+
+public:
+    /**
+     * 构造估计器
+     * @param fs 采样率
+     * @param c 声速
+     * @param noise_factor 门限相对噪底的倍数
+     * @param relative 门限相对最大峰的比例，应低于直达径相对最强反射径的幅值比，限制在 (0, 1] 内
+     * @param lobe 相关主瓣宽度（点），约为采样率与信号带宽之比
+     * @param interpolation 峰位插值方法
+     */
+    toa_estimator_t(
+        float fs, float c,
+        float noise_factor = 6,
+        float relative = .3f,
+        size_t lobe = 64,
+        interpolation_t interpolation = interpolation_t::sinc
+    ) : _fs(fs), _c(c),
+        _noise_factor(noise_factor), _relative(std::clamp(relative, std::numeric_limits<float>::min(), 1.0f)), _lobe(std::max<size_t>(lobe, 1)),
+        _interpolation(interpolation) {}
+    
+    /**
+     * 估计到达时刻
+     * @param correlation 相关输出
+     * @param origin 发射时刻（相关输出的点序号），飞行时间由此起算
+     * @return 估计结果，未检测到时 `found` 为假
+     */
+    [[nodiscard]]
+    arrival_t estimate(std::span<float const> correlation, float origin = 0) const {
+        arrival_t result{false, NAN, NAN, NAN, 0, 0};
+        const auto n = correlation.size();
+        if (n == 0) return result;
+        
+        // 归约：平方和与最大幅值
+        float square[lanes]{}, maximum[lanes]{};
+        
+        const auto body = n / lanes * lanes;
+        auto       p    = correlation.data();
+        for (size_t i = 0; i < body; i += lanes)
+            for (size_t k = 0; k < lanes; ++k) {
+                const auto x = p[i + k];
+                square[k] += x * x;
+                maximum[k] = std::max(maximum[k], std::abs(x));
+            }
+        for (auto i = body; i < n; ++i) {
+            square[0] += p[i] * p[i];
+            maximum[0] = std::max(maximum[0], std::abs(p[i]));
+        }
+        
+        float sum = 0, peak = 0;
+        for (size_t k = 0; k < lanes; ++k) {
+            sum += square[k];
+            peak = std::max(peak, maximum[k]);
+        }
+        
+        // 扣除最大峰两侧各一个主瓣宽度
+        const auto top   = static_cast<size_t>(std::find_if(p, p + n, [=](float x) { return std::abs(x) == peak; }) - p),
+                   begin = top > _lobe ? top - _lobe : 0,
+                   end   = std::min(n, top + _lobe + 1);
+        for (auto i = begin; i < end; ++i) sum -= p[i] * p[i];
+        const auto rest = n - (end - begin);
+        result.noise = rest ? std::sqrt(std::max(sum, 0.0f) / rest) : 0;
+        
+        const auto threshold = std::max(_noise_factor * result.noise, _relative * peak);
+        if (peak == 0 || peak < _noise_factor * result.noise) return result;
+        
+        // 前沿：第一个过门限的点，再在一个主瓣宽度内找顶点
+        size_t i = 0;
+        while (i < n && std::abs(p[i]) < threshold) ++i;
+        if (i == n) return result;
+        for (auto j = i + 1, end = std::min(n, i + _lobe); j < end; ++j)
+            if (std::abs(p[j]) > std::abs(p[i])) i = j;
+        
+        const auto sign = p[i] < 0 ? -1.0f : 1.0f;
+        result.found    = true;
+        result.peak     = p[i];
+        result.index    = refine(correlation, i, sign);
+        result.tof      = (result.index - origin) / _fs;
+        result.distance = result.tof * _c;
+        return result;
+    }
+};
+
+#endif // SIMULATION_TOA_ESTIMATOR_H
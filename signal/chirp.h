@@ -15,7 +15,7 @@
 std::function<float(float)>
 chirp_linear(float f0_hz, float f1_hz, float t_s, float phi0 = 0) {
     return [k = (f1_hz - f0_hz) / t_s / 2, f0_hz, phi0](float t) {
-        return std::sinf(2 * M_PI * (k * t + f0_hz) * t + phi0);
+        return std::sin(static_cast<float>(2 * M_PI * (k * t + f0_hz) * t + phi0));
     };
 }
 
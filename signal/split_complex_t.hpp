@@ -0,0 +1,181 @@
+#ifndef SIMULATION_SPLIT_COMPLEX_T_HPP
+#define SIMULATION_SPLIT_COMPLEX_T_HPP
+
+#include <vector>
+#include <cmath>
+#include <new>
+
+#include "complex_t.hpp"
+
+/// 按固定边界对齐的分配器
+template<class t, size_t _align = 64>
+struct aligned_allocator_t {
+    using value_type = t;
+    
+    template<class u>
+    struct rebind { using other = aligned_allocator_t<u, _align>; };
+    
+    aligned_allocator_t() = default;
+    
+    template<class u>
+    explicit aligned_allocator_t(aligned_allocator_t<u, _align> const &) {}
+    
+    [[nodiscard]]
+    t *allocate(size_t n) {
+        return static_cast<t *>(::operator new(n * sizeof(t), std::align_val_t{_align}));
+    }
+    
+    void deallocate(t *p, size_t) {
+        ::operator delete(p, std::align_val_t{_align});
+    }
+    
+    template<class u>
+    bool operator==(aligned_allocator_t<u, _align> const &) const { return true; }
+    
+    template<class u>
+    bool operator!=(aligned_allocator_t<u, _align> const &) const { return false; }
+};
+
+/**
+ * 分离存储的复数序列（实部、虚部各自连续对齐存放）
+ * @remarks 与 `std::vector<complex_t>` 相比，逐点运算不需要在实部虚部间交叉重排，便于向量化。
+ */
+struct split_complex_t {
+    using buffer_t = std::vector<float, aligned_allocator_t<float>>;
+    
+    buffer_t re, im;
+    
+    split_complex_t() = default;
+    
+    explicit split_complex_t(size_t size) : re(size, 0), im(size, 0) {}
+    
+    explicit split_complex_t(std::vector<complex_t> const &others)
+        : re(others.size()), im(others.size()) {
+        for (size_t i = 0; i < others.size(); ++i)
+            re[i] = others[i].re, im[i] = others[i].im;
+    }
+    
+    /// 转换为交错存储的复数序列
+    [[nodiscard]]
+    std::vector<complex_t> to_vector() const {
+        std::vector<complex_t> result(size());
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = {re[i], im[i]};
+        return result;
+    }
+    
+    [[nodiscard]]
+    inline size_t size() const {
+        return re.size();
+    }
+    
+    inline void resize(size_t size) {
+        re.resize(size, 0);
+        im.resize(size, 0);
+    }
+    
+    [[nodiscard]]
+    inline complex_t operator[](size_t i) const {
+        return {re[i], im[i]};
+    }
+    
+    inline void set(size_t i, complex_t value) {
+        re[i] = value.re;
+        im[i] = value.im;
+    }
+    
+    /// 逐点求模
+    [[nodiscard]]
+    std::vector<float> norm() const {
+        std::vector<float> result(size());
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]);
+        return result;
+    }
+    
+    /// 原地取共轭
+    split_complex_t &conjugate() {
+        for (auto &x : im) x = -x;
+        return *this;
+    }
+    
+    /// 原地归一化为单位模长（0 保持为 0）
+    split_complex_t &normalize() {
+        auto      pr = re.data(),
+                  pi = im.data();
+        for (auto i  = size(); i; --i, ++pr, ++pi) {
+            const auto l2 = *pr * *pr + *pi * *pi,
+                       k  = l2 == 0 ? 0 : 1 / std::sqrt(l2);
+            *pr *= k;
+            *pi *= k;
+        }
+        return *this;
+    }
+    
+    /// 逐点乘
+    split_complex_t &operator*=(split_complex_t const &others) {
+        auto      pr = re.data(),
+                  pi = im.data();
+        auto      qr = others.re.data(),
+                  qi = others.im.data();
+        for (auto i  = size(); i; --i, ++pr, ++pi, ++qr, ++qi) {
+            const auto r = *pr * *qr - *pi * *qi;
+            *pi = *pr * *qi + *pi * *qr;
+            *pr = r;
+        }
+        return *this;
+    }
+    
+    /// 逐点乘以另一序列的共轭
+    split_complex_t &multiply_conjugate(split_complex_t const &others) {
+        auto      pr = re.data(),
+                  pi = im.data();
+        auto      qr = others.re.data(),
+                  qi = others.im.data();
+        for (auto i  = size(); i; --i, ++pr, ++pi, ++qr, ++qi) {
+            const auto r = *pr * *qr + *pi * *qi;
+            *pi = *pi * *qr - *pr * *qi;
+            *pr = r;
+        }
+        return *this;
+    }
+    
+    /// 写入两序列的逐点积：this = a * b，尺寸须相同
+    split_complex_t &multiply(split_complex_t const &a, split_complex_t const &b) {
+        auto      pr = re.data(),
+                  pi = im.data();
+        auto      ar = a.re.data(),
+                  ai = a.im.data();
+        auto      br = b.re.data(),
+                  bi = b.im.data();
+        for (auto i  = size(); i; --i, ++pr, ++pi, ++ar, ++ai, ++br, ++bi) {
+            *pr = *ar * *br - *ai * *bi;
+            *pi = *ar * *bi + *ai * *br;
+        }
+        return *this;
+    }
+    
+    /// 累加两序列的逐点积：this += a * b
+    split_complex_t &multiply_add(split_complex_t const &a, split_complex_t const &b) {
+        auto      pr = re.data(),
+                  pi = im.data();
+        auto      ar = a.re.data(),
+                  ai = a.im.data();
+        auto      br = b.re.data(),
+                  bi = b.im.data();
+        for (auto i  = size(); i; --i, ++pr, ++pi, ++ar, ++ai, ++br, ++bi) {
+            *pr += *ar * *br - *ai * *bi;
+            *pi += *ar * *bi + *ai * *br;
+        }
+        return *this;
+    }
+    
+    template<class num_t>
+    split_complex_t &operator*=(const num_t &others) {
+        for (auto &x : re) x *= others;
+        for (auto &x : im) x *= others;
+        return *this;
+    }
+};
+
+#endif // SIMULATION_SPLIT_COMPLEX_T_HPP
@@ -0,0 +1,34 @@
+#ifndef SIMULATION_TESTS_CHECK_H
+#define SIMULATION_TESTS_CHECK_H
+
+#include <cmath>
+#include <cstdio>
+
+/// 失败计数，各测试的 main 以此为返回值
+inline int &failures() {
+    static int count = 0;
+    return count;
+}
+
+/// 检查条件，失败时打印位置并计数，不中断测试
+#define CHECK(condition)                                                            \
+    do {                                                                            \
+        if (!(condition)) {                                                         \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n",                       \
+                         __FILE__, __LINE__, #condition);                           \
+            ++failures();                                                           \
+        }                                                                           \
+    } while (false)
+
+/// 检查 |a - b| <= tolerance
+#define CHECK_NEAR(a, b, tolerance)                                                 \
+    do {                                                                            \
+        const double _a = (a), _b = (b);                                            \
+        if (!(std::abs(_a - _b) <= (tolerance))) {                                  \
+            std::fprintf(stderr, "%s:%d: check failed: %s = %g, %s = %g\n",         \
+                         __FILE__, __LINE__, #a, _a, #b, _b);                       \
+            ++failures();                                                           \
+        }                                                                           \
+    } while (false)
+
+#endif // SIMULATION_TESTS_CHECK_H
@@ -0,0 +1,104 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "../processing/fft.h"
+#include "check.h"
+
+/// 直接按定义计算 DFT，与 `fft_plan_t` 相同取 e^{+j} 核
+static std::vector<std::pair<double, double>> dft(std::vector<complex_t> const &x) {
+    const auto                             n = x.size();
+    std::vector<std::pair<double, double>> result(n);
+    for (size_t k = 0; k < n; ++k) {
+        double re = 0, im = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const auto theta = 2 * M_PI * static_cast<double>(i * k % n) / n,
+                       c     = std::cos(theta),
+                       s     = std::sin(theta);
+            re += x[i].re * c - x[i].im * s;
+            im += x[i].re * s + x[i].im * c;
+        }
+        result[k] = {re, im};
+    }
+    return result;
+}
+
+static std::vector<complex_t> signal(size_t n) {
+    std::vector<complex_t> x(n);
+    for (size_t i = 0; i < n; ++i)
+        x[i] = {static_cast<float>(std::sin(.37 * i) + .25 * std::cos(1.3 * i)),
+                static_cast<float>(std::cos(.11 * i * i / n) - .5)};
+    return x;
+}
+
+int main() {
+    // 基 4（含奇数级）、混合基、Bluestein（素数）长度
+    for (size_t n : {1, 2, 4, 8, 32, 256, 1024, 12, 60, 360, 210, 17, 101, 509}) {
+        const auto x        = signal(n);
+        const auto expected = dft(x);
+        const auto tolerance = 1e-5 * n;
+        
+        auto y = x;
+        cached_plan<fft_plan_t>(n).forward(y.data());
+        for (size_t k = 0; k < n; ++k) {
+            CHECK_NEAR(y[k].re, expected[k].first, tolerance);
+            CHECK_NEAR(y[k].im, expected[k].second, tolerance);
+        }
+        
+        // 反变换含 1/n，应还原
+        cached_plan<fft_plan_t>(n).inverse(y.data());
+        for (size_t i = 0; i < n; ++i) {
+            CHECK_NEAR(y[i].re, x[i].re, 1e-5);
+            CHECK_NEAR(y[i].im, x[i].im, 1e-5);
+        }
+        
+        // 分离存储与交错存储一致
+        std::vector<float> re(n), im(n);
+        for (size_t i = 0; i < n; ++i) re[i] = x[i].re, im[i] = x[i].im;
+        cached_plan<fft_plan_t>(n).forward(re.data(), im.data());
+        for (size_t k = 0; k < n; ++k) {
+            CHECK_NEAR(re[k], expected[k].first, tolerance);
+            CHECK_NEAR(im[k], expected[k].second, tolerance);
+        }
+    }
+    
+    // 实信号变换：非负频率部分与复数 DFT 一致
+    for (size_t n : {2, 8, 64, 1024, 12, 360}) {
+        auto x = signal(n);
+        for (auto &v : x) v.im = 0;
+        const auto expected = dft(x);
+        
+        std::vector<complex_t> spectrum(n / 2 + 1);
+        auto                   p = reinterpret_cast<float *>(spectrum.data());
+        for (size_t i = 0; i < n; ++i) p[i] = x[i].re;
+        cached_plan<rfft_plan_t>(n).forward(spectrum.data());
+        for (size_t k = 0; k <= n / 2; ++k) {
+            CHECK_NEAR(spectrum[k].re, expected[k].first, 1e-5 * n);
+            CHECK_NEAR(spectrum[k].im, expected[k].second, 1e-5 * n);
+        }
+        
+        cached_plan<rfft_plan_t>(n).inverse(spectrum.data());
+        for (size_t i = 0; i < n; ++i) CHECK_NEAR(p[i], x[i].re, 1e-5);
+    }
+    
+    // 非法长度抛出异常，不在计划缓存的锁内死循环；失败后缓存仍可用
+    auto rejects = [](auto const &make) {
+        try {
+            make();
+        } catch (std::invalid_argument const &) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(rejects([] { cached_plan<fft_plan_t>(0); }));
+    CHECK(rejects([] { cached_plan<fft_plan_t>(0); }));
+    CHECK(rejects([] { fft(nullptr, 0); }));
+    CHECK(rejects([] { rfft_plan_t plan(0); }));
+    CHECK(rejects([] { rfft_plan_t plan(7); }));
+    CHECK(rejects([] { cached_plan<rfft_plan_t>(1023); }));
+    CHECK(!rejects([] { cached_plan<rfft_plan_t>(2); }));
+    CHECK(cached_plan<fft_plan_t>(16).size() == 16);
+    
+    return failures();
+}
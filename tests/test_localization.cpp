@@ -0,0 +1,83 @@
+#include <vector>
+#include <cmath>
+
+#include "../processing/localization.h"
+#include "check.h"
+
+static std::vector<float> arrivals(std::vector<point_t> const &receivers, point_t p, float c, float offset) {
+    std::vector<float> t;
+    for (auto const &s : receivers) t.push_back((p - s).norm() / c + offset);
+    return t;
+}
+
+static void check_fix(position_fix_t const &fix, point_t p, double tolerance) {
+    CHECK(fix.valid);
+    CHECK_NEAR(fix.position.x, p.x, tolerance);
+    CHECK_NEAR(fix.position.y, p.y, tolerance);
+    CHECK_NEAR(fix.position.z, p.z, tolerance);
+}
+
+int main() {
+    constexpr float c = 1500;
+    
+    const std::vector<point_t> four{{0, 0, 0}, {10, 0, 1}, {0, 8, 2}, {9, 9, 6}},
+                               six{{0, 0, 0}, {10, 0, 1}, {0, 8, 2}, {9, 9, 6}, {5, -3, 4}, {-2, 6, 5}};
+    const point_t              target{4, 3, 2.5f};
+    constexpr float            offset = 2e-3f;
+    
+    { // 三维 TDOA，4 个接收器：未知数个数恰好等于接收器数，走闭式初值
+        position_solver_t solver(four, c, localization_mode_t::tdoa, 3, {5, 5, 3});
+        const auto        fix = solver.solve(arrivals(four, target, c, offset));
+        check_fix(fix, target, 1e-3);
+        CHECK(fix.receivers == 4);
+        CHECK_NEAR(fix.offset, offset, 1e-6);
+        CHECK(fix.residual < 1e-3);
+    }
+    
+    { // 三维 TDOA，6 个接收器：超定，含一路丢失
+        position_solver_t solver(six, c);
+        auto              t = arrivals(six, target, c, offset);
+        check_fix(solver.solve(t), target, 1e-3);
+        
+        t[2] = NAN;
+        const auto fix = solver.solve(t);
+        check_fix(fix, target, 1e-3);
+        CHECK(fix.receivers == 5);
+        
+        // 到达时刻带 ±1 μs 误差时，位置误差在厘米量级
+        t = arrivals(six, target, c, offset);
+        for (size_t i = 0; i < t.size(); ++i) t[i] += (i % 2 ? 1e-6f : -1e-6f);
+        check_fix(solver.solve(t), target, 2e-2);
+    }
+    
+    { // 二维 TOA 最小情形：2 个接收器，取离初值较近的根
+        const std::vector<point_t> two{{0, 0, 0}, {10, 0, 0}};
+        const point_t              p{3, 4, 0};
+        
+        position_solver_t above(two, c, localization_mode_t::toa, 2, {5, 5, 0});
+        check_fix(above.solve(arrivals(two, p, c, 0)), p, 1e-3);
+        
+        position_solver_t below(two, c, localization_mode_t::toa, 2, {5, -5, 0});
+        check_fix(below.solve(arrivals(two, p, c, 0)), {3, -4, 0}, 1e-3);
+    }
+    
+    { // 二维 TDOA 最小情形：3 个接收器
+        const std::vector<point_t> three{{0, 0, 0}, {10, 0, 0}, {0, 10, 0}};
+        const point_t              p{6, 2, 0};
+        position_solver_t          solver(three, c, localization_mode_t::tdoa, 2, {5, 5, 0});
+        const auto                 fix = solver.solve(arrivals(three, p, c, offset));
+        check_fix(fix, p, 1e-3);
+        CHECK_NEAR(fix.offset, offset, 1e-6);
+    }
+    
+    { // 有效接收器少于未知数个数时无效
+        position_solver_t solver(four, c);
+        auto              t = arrivals(four, target, c, offset);
+        t[0] = NAN;
+        const auto fix = solver.solve(t);
+        CHECK(!fix.valid);
+        CHECK(fix.receivers == 3);
+    }
+    
+    return failures();
+}
@@ -0,0 +1,62 @@
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+#include "../processing/monte_carlo.h"
+#include "../signal/chirp.h"
+#include "check.h"
+
+int main() {
+    CHECK(build_multi_path_response(0, 1e6f, 340, {{.5f, .1f, 1}}).empty());
+    
+    const auto response = build_multi_path_response(8, 1e6f, 1e6f, {{.5f, 3, 1}, {.25f, 20, 2}});
+    CHECK(response == std::vector<float>({1, 0, 0, -.5f, 0, 0, 0, 0}));
+    
+    monte_carlo_config_t config;
+    {
+        const auto chirp = chirp_linear(39e3f, 61e3f, 1e-3f);
+        for (size_t i = 0; i < 1000; ++i) config.reference.push_back(chirp(i / 1e6f));
+    }
+    config.snr        = {20_db, -20_db};
+    config.geometries = {{}, {{.6f, .05f, 1}}}; // 直达径；147 点后的反相反射径
+    config.trials     = 40;
+    config.frame      = 4096;
+    config.response   = 256;
+    config.delay      = 1000;
+    config.seed       = 7;
+    
+    thread_pool_t one(1), four(4);
+    const auto    serial   = monte_carlo(config, one),
+                  parallel = monte_carlo(config, four);
+    CHECK(serial.size() == 4);
+    
+    // 结果与线程数无关
+    for (size_t i = 0; i < serial.size(); ++i) {
+        CHECK(serial[i].snr.value == parallel[i].snr.value);
+        CHECK(serial[i].geometry == parallel[i].geometry);
+        CHECK(serial[i].trials == config.trials);
+        CHECK(serial[i].outlier_rate == parallel[i].outlier_rate);
+        CHECK(std::isnan(serial[i].bias) ? std::isnan(parallel[i].bias) : serial[i].bias == parallel[i].bias);
+        CHECK(std::isnan(serial[i].rmse) ? std::isnan(parallel[i].rmse) : serial[i].rmse == parallel[i].rmse);
+    }
+    
+    // 高信噪比下无离群，亚毫米精度；反射径不影响首达
+    for (size_t i : {0, 1}) {
+        CHECK(serial[i].outlier_rate == 0);
+        CHECK(std::abs(serial[i].bias) < 1e-3);
+        CHECK(serial[i].rmse < 1e-3);
+    }
+    // 低信噪比下离群率上升
+    CHECK(serial[2].outlier_rate > serial[0].outlier_rate);
+    
+    config.trials = 0;
+    bool rejected = false;
+    try {
+        monte_carlo(config, one);
+    } catch (std::invalid_argument const &) {
+        rejected = true;
+    }
+    CHECK(rejected);
+    
+    return failures();
+}
@@ -0,0 +1,69 @@
+#include <vector>
+#include <cmath>
+
+#include "../processing/multipath_channel.h"
+#include "../processing/signal_process.h"
+#include "check.h"
+
+int main() {
+    constexpr float fs = 1e6f, c = 1e6f; // 额外路程 1 米对应 1 点
+    constexpr size_t length = 512;
+    
+    std::vector<float> x(3000);
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<float>(std::sin(.05 * i) + .3 * std::sin(.4 * i) + (i % 11) / 11.0 - .5);
+    
+    { // 整数时延的静止声径与多径响应卷积一致，逐块送入不影响结果
+        const std::vector<path_info_t> paths{{.5f, 10, 1}, {.25f, 37, 2}, {.1f, 300, 3}, {.7f, 600, 1}};
+        const auto                     response = build_multi_path_response(length, fs, c, paths);
+        const auto                     expected = convolve(x, response, 4096);
+        
+        for (size_t chunk : {1, 100, 5000}) {
+            multipath_channel_t channel(fs, c, paths, length);
+            CHECK(channel.taps() == 4); // 超出最大时延的声径被忽略
+            
+            std::vector<float> y;
+            for (size_t i = 0; i < x.size(); i += chunk)
+                channel.process(x.data() + i, std::min(chunk, x.size() - i), y);
+            channel.flush(y);
+            
+            CHECK(y.size() == x.size() + length);
+            for (size_t i = 0; i < x.size() + length - 1; ++i)
+                CHECK_NEAR(y[i], expected[i], 1e-5);
+        }
+    }
+    
+    { // 分数时延：低频正弦经 12.3 点时延，与解析结果一致
+        std::vector<float> s(2000);
+        for (size_t i = 0; i < s.size(); ++i) s[i] = std::sin(.05f * i);
+        
+        multipath_channel_t channel(fs, c, {{1, 12.3f, 0}}, length, {}, 0, false);
+        const auto          y = channel.process(s);
+        for (size_t i = 100; i < s.size(); ++i)
+            CHECK_NEAR(y[i], std::sin(.05 * (i - 12.3)), 1e-4);
+    }
+    
+    { // 运动声径：第 n 点输出的时延为 20 + 0.001·n 点
+        std::vector<float> s(2000);
+        for (size_t i = 0; i < s.size(); ++i) s[i] = std::sin(.05f * i);
+        
+        multipath_channel_t channel(fs, c, {{1, 20, 0}}, length, {1e-3f * c}, 0, false);
+        const auto          y = channel.process(s);
+        for (size_t i = 100; i < s.size(); ++i)
+            CHECK_NEAR(y[i], std::sin(.05 * (i - 20 - 1e-3 * i)), 1e-4);
+    }
+    
+    { // 每次反射一级低通：直流增益为 1，高频衰减
+        multipath_channel_t channel(fs, c, {{1, 5, 2}}, length, {}, .5f, false);
+        
+        std::vector<float> dc(200, 1), nyquist(200);
+        for (size_t i = 0; i < nyquist.size(); ++i) nyquist[i] = i & 1u ? -1 : 1;
+        const auto a = channel.process(dc);
+        channel.reset();
+        const auto b = channel.process(nyquist);
+        CHECK_NEAR(a.back(), 1, 1e-4);
+        CHECK(std::abs(b.back()) < .2f);
+    }
+    
+    return failures();
+}
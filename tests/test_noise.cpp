@@ -0,0 +1,104 @@
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+#include "../processing/noise_model.h"
+#include "../processing/fft.h"
+#include "check.h"
+
+static double mean_square(std::vector<float> const &x, size_t begin = 0, size_t end = SIZE_MAX) {
+    end = std::min(end, x.size());
+    double sum = 0;
+    for (auto i = begin; i < end; ++i) sum += static_cast<double>(x[i]) * x[i];
+    return sum / static_cast<double>(end - begin);
+}
+
+/// 分段平均周期图，返回 n / 2 + 1 点功率谱
+static std::vector<double> psd(std::vector<float> const &x, size_t n) {
+    auto const             &plan = cached_plan<rfft_plan_t>(n);
+    std::vector<double>    result(n / 2 + 1, 0);
+    std::vector<complex_t> spectrum(n / 2 + 1);
+    for (size_t i = 0; i + n <= x.size(); i += n) {
+        std::copy(x.begin() + i, x.begin() + i + n, reinterpret_cast<float *>(spectrum.data()));
+        plan.forward(spectrum.data());
+        for (size_t k = 0; k <= n / 2; ++k) result[k] += spectrum[k].re * spectrum[k].re + spectrum[k].im * spectrum[k].im;
+    }
+    return result;
+}
+
+static double band_power(std::vector<double> const &p, size_t k0, size_t k1) {
+    double sum = 0;
+    for (auto k = k0; k < k1; ++k) sum += p[k];
+    return sum / static_cast<double>(k1 - k0);
+}
+
+template<class model_t>
+static std::vector<float> generate(model_t &&model, size_t length, uint64_t seed = 1) {
+    philox_t           generator(seed);
+    std::vector<float> x(length);
+    // 分成不规则的小块生成，检验跨块连续
+    for (size_t i = 0, n = 1; i < length; i += n, n = n * 7 % 1000 + 1)
+        model.generate(x.data() + i, std::min(n, length - i), generator);
+    return x;
+}
+
+int main() {
+    constexpr size_t length = 1u << 18u;
+    
+    // 各模型单位方差
+    CHECK_NEAR(mean_square(generate(white_noise_t(), length)), 1, .01);
+    CHECK_NEAR(mean_square(generate(pink_noise_t(), length)), 1, .1);
+    CHECK_NEAR(mean_square(generate(band_noise_t(1e6f, 1e5f, 2e5f), length)), 1, .02);
+    CHECK_NEAR(mean_square(generate(class_a_noise_t(.1f, .01f), length)), 1, .1);
+    
+    { // 粉红噪声功率谱每十倍频下降约 10 dB
+        const auto p     = psd(generate(pink_noise_t(), length), 4096);
+        const auto slope = 10 * std::log10(band_power(p, 200, 220) / band_power(p, 20, 22));
+        CHECK_NEAR(slope, -10, 1.5);
+    }
+    
+    { // 带限噪声的能量集中在通带内，阻带衰减超过 20 dB
+        const auto p = psd(generate(band_noise_t(1e6f, 1e5f, 2e5f), length), 1024);
+        // 1024 点谱，100~200 kHz 对应第 102~205 点
+        CHECK(band_power(p, 120, 185) > 100 * band_power(p, 300, 500));
+        CHECK(band_power(p, 120, 185) > 100 * band_power(p, 10, 80));
+    }
+    
+    { // 带限噪声开头即为稳态，没有滤波器启动过程
+        std::vector<float> head(64, 0);
+        double             sum = 0;
+        for (uint64_t seed = 0; seed < 400; ++seed) {
+            band_noise_t model(1e6f, 0, 2e5f);
+            philox_t     generator(seed);
+            model.generate(head.data(), head.size(), generator);
+            sum += mean_square(head, 0, 8);
+        }
+        CHECK_NEAR(sum / 400, 1, .15);
+    }
+    
+    { // A 类噪声为重尾分布：峰度远大于高斯的 3
+        const auto x = generate(class_a_noise_t(.1f, .01f), length);
+        double     m2 = 0, m4 = 0;
+        for (auto v : x) m2 += v * v, m4 += static_cast<double>(v) * v * v * v;
+        m2 /= x.size();
+        m4 /= x.size();
+        CHECK(m4 / (m2 * m2) > 10);
+    }
+    
+    // 非法参数
+    auto rejects = [](float a, float gamma) {
+        try {
+            class_a_noise_t model(a, gamma);
+        } catch (std::invalid_argument const &) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(rejects(0, .1f));
+    CHECK(rejects(-1, .1f));
+    CHECK(rejects(NAN, .1f));
+    CHECK(rejects(1, -.1f));
+    CHECK(!rejects(1, 0));
+    
+    return failures();
+}
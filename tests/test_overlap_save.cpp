@@ -0,0 +1,59 @@
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+#include "../processing/overlap_save.h"
+#include "check.h"
+
+/// 直接卷积，输出长度 x + h - 1
+static std::vector<double> direct(std::vector<float> const &x, std::vector<float> const &h) {
+    std::vector<double> y(x.size() + h.size() - 1, 0);
+    for (size_t i = 0; i < x.size(); ++i)
+        for (size_t j = 0; j < h.size(); ++j)
+            y[i + j] += static_cast<double>(x[i]) * h[j];
+    return y;
+}
+
+int main() {
+    std::vector<float> x(5000);
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<float>(std::sin(.05 * i) + .3 * std::sin(1.7 * i) + (i % 13) / 13.0 - .5);
+    
+    for (size_t taps : {1, 2, 31, 255, 1000}) {
+        std::vector<float> h(taps);
+        for (size_t i = 0; i < taps; ++i)
+            h[i] = static_cast<float>(std::exp(-3.0 * i / taps) * std::cos(.2 * i));
+        const auto expected = direct(x, h);
+        
+        // 默认变换长度和指定变换长度，逐块送入的块长与变换块长无关
+        for (size_t fft_size : {size_t{0}, 4 * taps + 6}) {
+            for (size_t chunk : {1, 7, 100, 4096}) {
+                overlap_save_t     filter(h, fft_size);
+                std::vector<float> y;
+                for (size_t i = 0; i < x.size(); i += chunk)
+                    filter.process(x.data() + i, std::min(chunk, x.size() - i), y);
+                filter.flush(y);
+                
+                CHECK(y.size() >= expected.size());
+                for (size_t i = 0; i < std::min(y.size(), expected.size()); ++i)
+                    CHECK_NEAR(y[i], expected[i], 1e-4 * std::sqrt(static_cast<double>(taps)));
+            }
+        }
+    }
+    
+    // 变换长度为奇数或小于滤波器长度时拒绝
+    auto rejects = [](size_t taps, size_t fft_size) {
+        try {
+            overlap_save_t filter(std::vector<float>(taps, 1), fft_size);
+        } catch (std::invalid_argument const &) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(rejects(16, 15));
+    CHECK(rejects(16, 14));
+    CHECK(rejects(16, 33));
+    CHECK(!rejects(16, 32));
+    
+    return failures();
+}
@@ -0,0 +1,120 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../processing/parallel_fft.h"
+#include "../processing/signal_process.h"
+#include "check.h"
+
+static std::vector<complex_t> signal(size_t n) {
+    std::vector<complex_t> x(n);
+    for (size_t i = 0; i < n; ++i)
+        x[i] = {static_cast<float>(std::sin(.37 * i) + .25 * std::cos(1.3 * i)),
+                static_cast<float>(std::cos(.11 * i * i / n) - .5)};
+    return x;
+}
+
+static double max_error(std::vector<complex_t> const &a, std::vector<complex_t> const &b) {
+    double error = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+        error = std::max({error, std::abs(static_cast<double>(a[i].re - b[i].re)),
+                          std::abs(static_cast<double>(a[i].im - b[i].im))});
+    return error;
+}
+
+int main() {
+    // 多于硬件线程数的工作线程，确保各步确实并发
+    thread_pool_t pool(4);
+    
+    // 四步法与单线程计划一致：2 的幂、混合基、行列不等、素数（退化为单线程）
+    for (size_t n : {1024, 65536, 3072, 2 * 509, 509}) {
+        const auto x = signal(n);
+        
+        auto expected = x;
+        cached_plan<fft_plan_t>(n).forward(expected.data());
+        auto y = x;
+        fft(y.data(), n, pool);
+        CHECK(max_error(y, expected) <= 1e-6 * n);
+        
+        ifft(y.data(), n, pool);
+        CHECK(max_error(y, x) <= 1e-5);
+    }
+    
+    { // 批量变换：连续存放的帧与每帧一个向量
+        constexpr size_t n = 360, count = 7;
+        
+        std::vector<complex_t>              frames;
+        std::vector<std::vector<complex_t>> vectors, expected;
+        for (size_t i = 0; i < count; ++i) {
+            auto x = signal(n);
+            for (auto &v : x) v.re *= static_cast<float>(i + 1);
+            frames.insert(frames.end(), x.begin(), x.end());
+            vectors.push_back(x);
+            cached_plan<fft_plan_t>(n).forward(x.data());
+            expected.push_back(std::move(x));
+        }
+        
+        fft_batch(frames.data(), n, count, pool);
+        fft_batch(vectors, pool);
+        for (size_t i = 0; i < count; ++i) {
+            std::vector<complex_t> frame(frames.begin() + i * n, frames.begin() + (i + 1) * n);
+            CHECK(max_error(frame, expected[i]) <= 1e-5 * n);
+            CHECK(max_error(vectors[i], expected[i]) == 0);
+        }
+        
+        fft_batch(vectors, pool, true);
+        for (size_t i = 0; i < count; ++i) {
+            auto x = signal(n);
+            for (auto &v : x) v.re *= static_cast<float>(i + 1);
+            CHECK(max_error(vectors[i], x) <= 1e-5 * (i + 1));
+        }
+    }
+    
+    { // 批量实变换：与复数变换的非负频率部分一致，不足长度补 0，反变换还原
+        constexpr size_t n = 256;
+        
+        std::vector<std::vector<float>> signals;
+        for (size_t length : {256, 100, 300}) {
+            std::vector<float> s(length);
+            for (size_t i = 0; i < length; ++i) s[i] = std::sin(.05f * i * i / length) + .1f * i / length;
+            signals.push_back(std::move(s));
+        }
+        
+        auto spectra = rfft_batch(signals, n, pool);
+        CHECK(spectra.size() == signals.size());
+        for (size_t i = 0; i < signals.size(); ++i) {
+            std::vector<complex_t> x(n, complex_t::zero);
+            for (size_t j = 0; j < std::min(n, signals[i].size()); ++j) x[j] = {signals[i][j], 0};
+            cached_plan<fft_plan_t>(n).forward(x.data());
+            x.resize(n / 2 + 1);
+            CHECK(spectra[i].size() == n / 2 + 1);
+            CHECK(max_error(spectra[i], x) <= 1e-5 * n);
+        }
+        
+        auto restored = irfft_batch(spectra, n, pool);
+        for (size_t i = 0; i < signals.size(); ++i)
+            for (size_t j = 0; j < n; ++j)
+                CHECK_NEAR(restored[i][j], j < signals[i].size() ? signals[i][j] : 0, 1e-5);
+    }
+    
+    { // 分组实变换的各组变换在线程池上并行，结果与单次变换一致
+        std::vector<float> s(1000);
+        for (size_t i = 0; i < s.size(); ++i) s[i] = std::cos(.3f * i) * (1 + .001f * i);
+        
+        const auto expected = fft_real<1024>(s);
+        CHECK(max_error(fft_real<256, 4>(s, pool), expected) <= 1e-3);
+        CHECK(max_error(fft_real<256, 4>(s, pool), fft_real<256, 4>(s)) == 0);
+    }
+    
+    { // 重采样的大点数反变换走四步法，与单线程路径一致
+        std::vector<float> s(500);
+        for (size_t i = 0; i < s.size(); ++i) s[i] = std::sin(.2f * i);
+        
+        const auto expected = resample<16, 1024, 256>(s, 1e6f, 4e5f);
+        const auto actual   = resample<16, 1024, 256>(s, 1e6f, 4e5f, pool);
+        for (size_t i = 0; i < expected.size(); ++i)
+            CHECK_NEAR(actual[i], expected[i], 1e-4);
+    }
+    
+    return failures();
+}
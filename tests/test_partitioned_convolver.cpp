@@ -0,0 +1,57 @@
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+#include "../processing/partitioned_convolver.h"
+#include "../processing/signal_process.h"
+#include "check.h"
+
+int main() {
+    std::vector<float> x(3000);
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<float>(std::sin(.05 * i) + .3 * std::sin(1.7 * i) + (i % 13) / 13.0 - .5);
+    
+    // 滤波器短于、等于、长于块长，以及不整除块长的情形
+    for (size_t taps : {1, 64, 100, 1000}) {
+        std::vector<float> h(taps);
+        for (size_t i = 0; i < taps; ++i)
+            h[i] = static_cast<float>(std::exp(-3.0 * i / taps) * std::cos(.2 * i));
+        
+        // 参考结果：一次快速卷积，变换长度足以容纳完整的线性卷积
+        size_t size = 2;
+        while (size < x.size() + taps - 1) size <<= 1u;
+        const auto expected = convolve(x, h, size);
+        
+        for (size_t block : {1, 64, 256}) {
+            for (size_t chunk : {1, 37, 4096}) {
+                partitioned_convolver_t convolver(h, block);
+                CHECK(convolver.partitions() == (taps + block - 1) / block);
+                
+                std::vector<float> y;
+                for (size_t i = 0; i < x.size(); i += chunk)
+                    convolver.process(x.data() + i, std::min(chunk, x.size() - i), y);
+                convolver.flush(y);
+                
+                CHECK(y.size() == x.size() + taps - 1);
+                for (size_t i = 0; i < std::min(y.size(), x.size() + taps - 1); ++i)
+                    CHECK_NEAR(y[i], expected[i], 1e-4 * std::sqrt(static_cast<double>(taps)));
+            }
+        }
+    }
+    
+    // 块长为 0 或冲激响应为空时拒绝
+    auto rejects = [](size_t taps, size_t block) {
+        try {
+            partitioned_convolver_t convolver(std::vector<float>(taps, 1), block);
+        } catch (std::invalid_argument const &) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(rejects(16, 0));
+    CHECK(rejects(0, 16));
+    CHECK(rejects(0, 0));
+    CHECK(!rejects(1, 1));
+    
+    return failures();
+}
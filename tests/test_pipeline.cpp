@@ -0,0 +1,112 @@
+#include <vector>
+#include <cmath>
+
+#include "../processing/pipeline.h"
+#include "../processing/pipeline_stages.h"
+#include "../processing/signal_process.h"
+#include "check.h"
+
+static std::vector<float> run(pipeline_t &chain, std::vector<float> const &x, size_t chunk) {
+    std::vector<float> y;
+    for (size_t i = 0; i < x.size(); i += chunk)
+        chain.process(x.data() + i, std::min(chunk, x.size() - i), y);
+    chain.flush(y);
+    return y;
+}
+
+int main() {
+    constexpr float fs = 1e6f, c = 1500;
+    
+    std::vector<float> x(5000);
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<float>(std::sin(2 * M_PI * 50e3 * i / fs) * std::exp(-1e-3 * i) + (i % 17) / 17.0 - .5);
+    
+    const std::vector<path_info_t> paths{{.5f, .3f, 1}, {.25f, .75f, 2}};
+    constexpr size_t               taps = 101, length = 1024;
+    
+    { // 带通级与多径级串联，与离线卷积结果一致，且与送入的块长无关
+        size_t size = 2;
+        while (size < x.size() + taps + length) size <<= 1u;
+        const auto bandpass = resampler::bandpass(taps, (taps - 1) / 2.0, 30e3 / fs, 70e3 / fs);
+        const auto response = build_multi_path_response(length, fs, c, paths);
+        const auto expected = convolve(convolve(x, bandpass, size), response, size);
+        
+        for (size_t chunk : {1, 100, 8192}) {
+            pipeline_t chain(64);
+            chain.then(pipeline::bandpass_stage(fs, 30e3f, 70e3f, taps))
+                 .then(pipeline::multipath_stage(fs, c, paths, length, 128));
+            const auto y = run(chain, x, chunk);
+            
+            CHECK(y.size() == x.size() + taps - 1 + length - 1);
+            for (size_t i = 0; i < std::min(y.size(), expected.size()); ++i)
+                CHECK_NEAR(y[i], expected[i], 1e-4);
+        }
+    }
+    
+    { // 带通级的通带增益为 1，阻带衰减
+        auto tone = [](float f) {
+            std::vector<float> s(4000);
+            for (size_t i = 0; i < s.size(); ++i) s[i] = std::sin(static_cast<float>(2 * M_PI * f * i / fs));
+            return s;
+        };
+        auto rms = [](std::vector<float> const &s) {
+            double sum = 0;
+            for (size_t i = 1000; i < 3000; ++i) sum += s[i] * s[i];
+            return std::sqrt(sum / 2000);
+        };
+        pipeline_t chain;
+        chain.then(pipeline::bandpass_stage(fs, 30e3f, 70e3f));
+        CHECK_NEAR(rms(run(chain, tone(50e3f), 256)), std::sqrt(.5), .01);
+        CHECK(rms(run(chain, tone(150e3f), 256)) < 1e-3);
+    }
+    
+    { // 加噪级：平稳信号上信噪比符合设定，reset 后重放同一段噪声
+        std::vector<float> x(20000);
+        for (size_t i = 0; i < x.size(); ++i) x[i] = std::sin(static_cast<float>(2 * M_PI * 50e3 * i / fs));
+        
+        pipeline_t chain(128);
+        chain.then(pipeline::noise_stage_t(0_db, white_noise_t(), philox_t(3)));
+        const auto y0 = run(chain, x, 1000);
+        chain.reset();
+        const auto y1 = run(chain, x, 1000);
+        CHECK(y0 == y1);
+        CHECK(y0.size() == x.size());
+        
+        double signal = 0, noise = 0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            signal += x[i] * x[i];
+            noise += (y0[i] - x[i]) * (y0[i] - x[i]);
+        }
+        CHECK_NEAR(10 * std::log10(signal / noise), 0, .3);
+    }
+    
+    { // 有状态的逐点级在 reset 后回到初始状态
+        pipeline_t chain(16);
+        chain.map([n = 0.0f](float v) mutable { return v + n++; });
+        const std::vector<float> zeros(40, 0);
+        const auto               y0 = run(chain, zeros, 7);
+        chain.reset();
+        const auto               y1 = run(chain, zeros, 40);
+        CHECK(y0 == y1);
+        CHECK(y0.size() == 40 && y0.back() == 39);
+    }
+    
+    { // 完整链路：带通、多径、加噪、包络，逐块与整段送入结果一致
+        auto make = [&] {
+            pipeline_t chain(256);
+            chain.then(pipeline::bandpass_stage(fs, 30e3f, 70e3f))
+                 .then(pipeline::multipath_stage(fs, c, paths, length))
+                 .then(pipeline::noise_stage_t(20_db, pink_noise_t(), philox_t(9), 256))
+                 .map([](float v) { return std::abs(v); });
+            return chain;
+        };
+        auto a = make(), b = make();
+        CHECK(a.stages() == 4);
+        const auto y0 = run(a, x, 100);
+        const auto y1 = run(b, x, x.size());
+        CHECK(y0 == y1);
+        CHECK(y0.size() == x.size() + 254 + length - 1);
+    }
+    
+    return failures();
+}
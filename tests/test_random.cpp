@@ -0,0 +1,59 @@
+#include <vector>
+#include <cmath>
+
+#include "../processing/random.h"
+#include "check.h"
+
+/// 已知答案测试：SplitMix64、xoshiro256++、Philox4x32-10 的参考输出
+int main() {
+    // SplitMix64，种子 0
+    {
+        splitmix64_t generator(0);
+        CHECK(generator() == 0xe220a8397b1dcdafu);
+        CHECK(generator() == 0x6e789e6aa1b965f4u);
+        CHECK(generator() == 0x06c45d188009454fu);
+        CHECK(generator() == 0xf88bb8a8724c81ecu);
+    }
+    
+    // xoshiro256++，状态由上面 4 个 SplitMix64 输出展开：rotl(s0 + s3, 23) + s0
+    {
+        xoshiro256_t generator(0);
+        CHECK(generator() == 0x53175d61490b23dfu);
+    }
+    
+    // Philox4x32-10，密钥 0，计数器 0（Random123 参考向量）
+    {
+        philox_t generator(0, 0, 0);
+        CHECK(generator.next32() == 0x6627e8d5u);
+        CHECK(generator.next32() == 0xe169c58du);
+        CHECK(generator.next32() == 0xbc57ac4cu);
+        CHECK(generator.next32() == 0x9b00dbd8u);
+    }
+    
+    // Philox 可随机访问：从第 1 组开始与顺序取到第 1 组一致
+    {
+        philox_t sequential(7, 3), skipped(7, 3, 1);
+        for (auto i = 0; i < 4; ++i) sequential.next32();
+        for (auto i = 0; i < 8; ++i) CHECK(sequential.next32() == skipped.next32());
+    }
+    
+    // 同一（种子，流）结果可复现，高斯样本的均值和方差
+    {
+        std::vector<float> a(1 << 16), b(1 << 16);
+        philox_t           g0(42, 5), g1(42, 5);
+        fill_gaussian(a.data(), a.size(), 2, g0);
+        fill_gaussian(b.data(), b.size(), 2, g1);
+        CHECK(a == b);
+        
+        double sum = 0, square = 0;
+        for (auto x : a) {
+            sum += x;
+            square += x * x;
+        }
+        const auto mean = sum / a.size();
+        CHECK_NEAR(mean, 0, .05);
+        CHECK_NEAR(square / a.size() - mean * mean, 4, .1);
+    }
+    
+    return failures();
+}
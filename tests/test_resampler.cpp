@@ -0,0 +1,55 @@
+#include <vector>
+#include <cmath>
+
+#include "../processing/resampler.h"
+#include "check.h"
+
+/// 带限测试信号：两个低频正弦之和，t 以输入采样点为单位
+static float tone(double t, double fs) {
+    return static_cast<float>(std::sin(2 * M_PI * 20e3 * t / fs) + .5 * std::sin(2 * M_PI * 47e3 * t / fs + 1));
+}
+
+/// 去掉两端过渡段后的最大误差
+static double max_error(std::vector<float> const &y, double fs, size_t margin) {
+    double error = 0;
+    for (auto i = margin; i + margin < y.size(); ++i)
+        error = std::max(error, std::abs(static_cast<double>(y[i]) - tone(static_cast<double>(i), fs)));
+    return error;
+}
+
+int main() {
+    constexpr double fs = 1e6;
+    
+    std::vector<float> x(6000);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = tone(static_cast<double>(i), fs);
+    
+    { // 有理近似：3/2 升采样再 2/3 降采样，输出与理想采样一致、往返后还原
+        const auto up   = resample_polyphase(x, 1e6f, 1.5e6f, 9000);
+        const auto back = resample_polyphase(up, 1.5e6f, 1e6f, 6000);
+        CHECK(max_error(up, 1.5e6, 200) < 2e-3);
+        CHECK(max_error(back, fs, 200) < 4e-3);
+    }
+    
+    { // 多相重采样器逐块送入与整段送入一致，flush 后总点数与比例相符
+        polyphase_resampler_t resampler(5, 3);
+        CHECK(resampler.up() == 5);
+        std::vector<float>    a, b;
+        for (size_t i = 0; i < x.size(); i += 77)
+            resampler.process(x.data() + i, std::min<size_t>(77, x.size() - i), a);
+        resampler.flush(a);
+        resampler.process(x.data(), x.size(), b);
+        resampler.flush(b);
+        CHECK(a == b);
+        CHECK(a.size() == (x.size() * 5 + 2) / 3);
+    }
+    
+    { // 无理比例走 Farrow 结构：往返误差受三次插值限制
+        const auto ratio = std::sqrt(2.0);
+        const auto up    = resample_polyphase(x, 1e6f, static_cast<float>(fs * ratio), 8486, 16);
+        const auto back  = resample_polyphase(up, static_cast<float>(fs * ratio), 1e6f, 6000, 16);
+        CHECK(max_error(up, fs * ratio, 200) < 1e-3);
+        CHECK(max_error(back, fs, 200) < 1e-2);
+    }
+    
+    return failures();
+}
@@ -0,0 +1,76 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../processing/room.h"
+#include "check.h"
+
+static float distance(point_t a, point_t b) {
+    return (a - b).norm();
+}
+
+int main() {
+    const point_t size{5, 4, 3}, source{1, 1.5f, 1}, receiver{3.5f, 2, 2.4f};
+    const auto    d0 = distance(source, receiver);
+    
+    // 三维 k 阶镜像共 4k²+2 个，二维共 4k 个
+    CHECK(image_source_model_t(size, source, {.9f, .9f, .9f, .9f, .9f, .9f}, 1).images() == 6);
+    CHECK(image_source_model_t(size, source, {.9f, .9f, .9f, .9f, .9f, .9f}, 2).images() == 6 + 18);
+    CHECK(image_source_model_t(size, source, {.9f, .9f, .9f, .9f, .9f, .9f}, 3).images() == 6 + 18 + 38);
+    CHECK(image_source_model_t({5, 4, 0}, source, {.9f, .9f, .9f, .9f, 0, 0}, 3).images() == 4 + 8 + 12);
+    
+    { // 一阶反射：每面一条声径，额外路程和增益与手算的镜像一致
+        const std::array<float, 6> beta{.9f, .8f, .7f, .6f, .5f, .4f};
+        image_source_model_t       room(size, source, beta, 1);
+        
+        const point_t images[6]{
+            {-source.x, source.y, source.z}, {2 * size.x - source.x, source.y, source.z},
+            {source.x, -source.y, source.z}, {source.x, 2 * size.y - source.y, source.z},
+            {source.x, source.y, -source.z}, {source.x, source.y, 2 * size.z - source.z},
+        };
+        
+        auto paths = room.paths(receiver, 100, 0);
+        CHECK(paths.size() == 6);
+        for (size_t i = 0; i < 6; ++i) {
+            const auto d = distance(images[i], receiver);
+            auto       p = std::find_if(paths.begin(), paths.end(), [&](path_info_t const &path) {
+                return std::abs(path.ds - (d - d0)) < 1e-4f;
+            });
+            CHECK(p != paths.end());
+            if (p == paths.end()) continue;
+            CHECK(p->reflect_times == 1);
+            CHECK_NEAR(p->a, beta[i] * d0 / d, 1e-5);
+        }
+    }
+    
+    { // 高阶：路程上限和增益门限剪除声径，剩余声径都满足限制
+        const std::array<float, 6> beta{.9f, .9f, .9f, .9f, .9f, .9f};
+        image_source_model_t       room(size, source, beta, 6);
+        
+        const auto all     = room.paths(receiver, 1000, 0),
+                   near    = room.paths(receiver, 10, 0),
+                   strong  = room.paths(receiver, 1000, .2f);
+        CHECK(all.size() == room.images());
+        CHECK(near.size() < all.size());
+        CHECK(strong.size() < all.size());
+        for (auto const &path : near) CHECK(path.ds <= 10);
+        for (auto const &path : strong) CHECK(path.a >= .2f);
+        CHECK(near.size() == static_cast<size_t>(std::count_if(all.begin(), all.end(), [](path_info_t const &p) {
+            return p.ds <= 10;
+        })));
+    }
+    
+    { // 房间内的障碍物：镜面反射点落在矩形内时多一条一次反射声径
+        const reflector_t    plate{{2, 0, 0}, {1, 0, 0}, {0, 0, 3}, .5f}; // y = 0 平面上 2 <= x <= 3 的一条
+        image_source_model_t room(size, source, {0, 0, 0, 0, 0, 0}, 1, {plate});
+        
+        // 源 (1,1.5)、收 (3.5,2) 对 y=0 的镜面反射点 x = 1 + 2.5·1.5/3.5 ≈ 2.07，落在板内
+        const auto paths = room.paths(receiver, 100, 0);
+        CHECK(std::count_if(paths.begin(), paths.end(), [](path_info_t const &p) { return p.a > 0; }) == 1);
+        const auto d = distance({source.x, -source.y, source.z}, receiver);
+        for (auto const &p : paths)
+            if (p.a > 0) CHECK_NEAR(p.ds, d - d0, 1e-4);
+    }
+    
+    return failures();
+}
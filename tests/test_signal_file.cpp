@@ -0,0 +1,91 @@
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+#include "../processing/signal_file.h"
+#include "../processing/signal_reader.h"
+#include "check.h"
+
+template<class function_t>
+static bool throws(function_t const &function) {
+    try {
+        function();
+    } catch (std::runtime_error const &) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    const std::string name = "test_signal_file.sig";
+    
+    { // 长于写入块的单通道信号：写入、映射、流式读取一致
+        std::vector<float> signal(200000);
+        for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(.01f * i) * i;
+        save_signal_binary(name, signal, 1e6);
+        
+        mapped_signal_t mapped(name);
+        CHECK(mapped.header().fs == 1e6);
+        CHECK(mapped.size() == signal.size());
+        CHECK(mapped.channel<float>() == signal);
+        CHECK(load_signal_binary<float>(name) == signal);
+        
+        signal_reader_t    reader(name, 4096);
+        std::vector<float> chunk, read;
+        while (reader.next(chunk)) read.insert(read.end(), chunk.begin(), chunk.end());
+        CHECK(read == signal);
+    }
+    
+    { // 多通道交错写入，帧跨越多次调用和缓冲区边界
+        constexpr uint32_t channels = 3;
+        constexpr size_t   frames   = 1001;
+        
+        std::vector<int16_t> samples(frames * channels);
+        for (size_t i = 0; i < samples.size(); ++i) samples[i] = static_cast<int16_t>(i * 37 % 65536 - 32768);
+        {
+            signal_writer_t<int16_t> writer(name, 48e3, channels, 7);
+            for (size_t i = 0; i < samples.size(); i += 5)
+                writer.write(samples.data() + i, std::min<size_t>(5, samples.size() - i));
+            writer.close();
+        }
+        
+        mapped_signal_t mapped(name);
+        CHECK(mapped.size() == frames);
+        CHECK(mapped.header().channels == channels);
+        for (size_t c = 0; c < channels; ++c) {
+            auto channel = mapped.channel<int16_t>(c);
+            CHECK(channel.size() == frames);
+            for (size_t i = 0; i < frames; ++i) CHECK(channel[i] == samples[i * channels + c]);
+            
+            signal_reader_t    reader(name, 64, 2, c);
+            std::vector<float> chunk, read;
+            while (reader.next(chunk)) read.insert(read.end(), chunk.begin(), chunk.end());
+            CHECK(read.size() == frames);
+            for (size_t i = 0; i < std::min(frames, read.size()); ++i)
+                CHECK(read[i] == samples[i * channels + c]);
+        }
+        CHECK(throws([&] { mapped.channel<int16_t>(channels); }));
+        CHECK(throws([&] { mapped.data<float>(); }));
+        CHECK(throws([&] { signal_reader_t reader(name, 64, 2, channels); }));
+    }
+    
+    { // 文件头中的长度超出文件大小（含乘积溢出的情形）时拒绝映射
+        for (uint64_t length : {uint64_t{5}, uint64_t{1} << 62u, ~uint64_t{0} / 3 + 1}) {
+            signal_header_t header;
+            header.channels = 3;
+            header.length   = length;
+            const float payload[4]{};
+            auto        file = std::fopen(name.c_str(), "wb");
+            std::fwrite(&header, sizeof header, 1, file);
+            std::fwrite(payload, sizeof payload, 1, file);
+            std::fclose(file);
+            CHECK(throws([&] { mapped_signal_t mapped(name); }));
+        }
+    }
+    
+    std::remove(name.c_str());
+    return failures();
+}
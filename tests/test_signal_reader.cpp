@@ -0,0 +1,77 @@
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+
+#include "../processing/signal_reader.h"
+#include "check.h"
+
+static std::vector<float> read_all(std::string const &name, size_t block, size_t depth = 4, size_t channel = 0) {
+    signal_reader_t    reader(name, block, depth, channel);
+    std::vector<float> chunk, result;
+    while (reader.next(chunk)) {
+        if (chunk.size() > block) return {};
+        result.insert(result.end(), chunk.begin(), chunk.end());
+    }
+    CHECK(!reader.next(chunk));
+    return result;
+}
+
+int main() {
+    const std::string text = "test_signal_reader.txt", binary = "test_signal_reader.sig";
+    
+    std::vector<float> x(10007);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = std::round(1000 * std::sin(.01f * i)) / 8;
+    
+    { // 文本文件：空白与逗号混合分隔，任意块长读出的序列与写入的相同
+        std::ofstream file(text);
+        for (size_t i = 0; i < x.size(); ++i) file << x[i] << (i % 3 == 0 ? "," : i % 3 == 1 ? " \t" : "\n");
+    }
+    for (size_t block : {1, 64, 4096, 20000}) CHECK(read_all(text, block, 2) == x);
+    
+    { // 二进制文件：各采样点类型转换为 float
+        {
+            signal_writer_t<double> writer(binary, 1e6);
+            for (auto v : x) {
+                const double d = v;
+                writer.write(&d, 1);
+            }
+        }
+        CHECK(read_all(binary, 1000) == x);
+        
+        std::vector<uint16_t> u(x.size());
+        for (size_t i = 0; i < u.size(); ++i) u[i] = static_cast<uint16_t>(x[i] + 200);
+        save_signal_binary(binary, u);
+        const auto y = read_all(binary, 333);
+        CHECK(y.size() == u.size());
+        for (size_t i = 0; i < std::min(y.size(), u.size()); ++i) CHECK(y[i] == u[i]);
+        
+        std::vector<complex_t> z(x.size());
+        for (size_t i = 0; i < z.size(); ++i) z[i] = {x[i], -x[i]};
+        save_signal_binary(binary, z);
+        CHECK(read_all(binary, 4096) == x); // 复数取实部
+    }
+    
+    { // 文件头可读，空文件没有数据，不存在的文件抛出异常
+        signal_reader_t reader(binary);
+        CHECK(reader.header().type == sample_type_t::c32);
+        CHECK(reader.header().length == x.size());
+        
+        std::ofstream(text).close();
+        CHECK(read_all(text, 16).empty());
+        
+        bool thrown = false;
+        try {
+            signal_reader_t missing("test_signal_reader.missing");
+        } catch (std::runtime_error const &) {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+    
+    std::remove(text.c_str());
+    std::remove(binary.c_str());
+    return failures();
+}
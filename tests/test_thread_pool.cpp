@@ -0,0 +1,44 @@
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+
+#include "../processing/thread_pool.h"
+#include "check.h"
+
+int main() {
+    for (size_t threads : {1, 2, 4}) {
+        thread_pool_t pool(threads);
+        
+        // 每个下标恰好执行一次，工作线程序号在范围内
+        std::vector<std::atomic<int>> hits(1000);
+        std::atomic<bool>             range{true};
+        pool.parallel_for(hits.size(), [&](size_t i, size_t worker) {
+            ++hits[i];
+            if (worker >= pool.size()) range = false;
+        });
+        for (auto const &h : hits) CHECK(h == 1);
+        CHECK(range);
+        
+        // 嵌套调用不死锁
+        std::atomic<size_t> total{0};
+        pool.parallel_for(8, [&](size_t, size_t) {
+            pool.parallel_for(8, [&](size_t, size_t) {
+                pool.parallel_for(4, [&](size_t, size_t) { ++total; });
+            });
+        });
+        CHECK(total == 8 * 8 * 4);
+        
+        // 循环体的异常在调用方重新抛出
+        auto caught = false;
+        try {
+            pool.parallel_for(100, [](size_t i, size_t) {
+                if (i == 37) throw std::runtime_error("task failed");
+            });
+        } catch (std::runtime_error const &) {
+            caught = true;
+        }
+        CHECK(caught);
+    }
+    
+    return failures();
+}
@@ -0,0 +1,63 @@
+#include <vector>
+#include <cmath>
+
+#include "../processing/toa_estimator.h"
+#include "../processing/signal_process.h"
+#include "../processing/noise.h"
+#include "../signal/chirp.h"
+#include "check.h"
+
+int main() {
+    constexpr float  fs = 1e6f, c = 1500;
+    constexpr size_t size = 8192;
+    
+    // 39~61 kHz、1 ms 线性调频，相关主瓣宽度约 fs / 带宽 ≈ 45 点
+    std::vector<float> reference(1000);
+    {
+        const auto chirp = chirp_linear(39e3f, 61e3f, 1e-3f);
+        for (size_t i = 0; i < reference.size(); ++i) reference[i] = chirp(i / fs);
+    }
+    const auto filter = xcorr_init(reference, size);
+    
+    /// 在 delay 处（可为小数）放一份参考信号，用发射信号的解析表达式求值
+    auto received = [&](double delay, float a, std::vector<float> &signal) {
+        const auto chirp = chirp_linear(39e3f, 61e3f, 1e-3f);
+        for (size_t i = 0; i < signal.size(); ++i) {
+            const auto t = (i - delay) / fs;
+            if (t >= 0 && t < 1e-3) signal[i] += a * chirp(static_cast<float>(t));
+        }
+    };
+    
+    for (auto interpolation : {toa_estimator_t::interpolation_t::parabolic, toa_estimator_t::interpolation_t::sinc}) {
+        const toa_estimator_t estimator(fs, c, 6, .3f, 45, interpolation);
+        const auto            tolerance = interpolation == toa_estimator_t::interpolation_t::sinc ? .05 : .25;
+        
+        for (double delay : {1500.0, 2345.25, 3000.5}) {
+            // 直达径之后 300 点有一条更强的反射径，加 10 dB 噪声
+            std::vector<float> signal(size, 0);
+            received(delay, 1, signal);
+            received(delay + 300, 1.5f, signal);
+            philox_t generator(static_cast<uint64_t>(delay));
+            add_noise(signal, 10_db, generator);
+            xcorr(filter, signal, size);
+            
+            const auto arrival = estimator.estimate(signal, 1000);
+            CHECK(arrival.found);
+            CHECK_NEAR(arrival.index, delay, tolerance);
+            CHECK_NEAR(arrival.tof, (delay - 1000) / fs, tolerance / fs);
+            CHECK_NEAR(arrival.distance, (delay - 1000) / fs * c, tolerance / fs * c);
+            CHECK(arrival.peak > 6 * arrival.noise);
+        }
+    }
+    
+    { // 只有噪声时不报告到达
+        std::vector<float> signal(size, 0);
+        philox_t           generator(1);
+        fill_gaussian(signal.data(), signal.size(), 1, generator);
+        xcorr(filter, signal, size);
+        CHECK(!toa_estimator_t(fs, c).estimate(signal).found);
+        CHECK(!toa_estimator_t(fs, c).estimate(std::vector<float>(100, 0)).found);
+    }
+    
+    return failures();
+}
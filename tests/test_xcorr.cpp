@@ -0,0 +1,92 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../processing/signal_process.h"
+#include "../processing/stream_correlator.h"
+#include "check.h"
+
+static std::vector<float> chirp(size_t n, float k) {
+    std::vector<float> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = std::sin(k * i * i + .1f * i);
+    return x;
+}
+
+int main() {
+    constexpr size_t size = 1024;
+    
+    const auto reference = chirp(200, 1e-3f);
+    std::vector<float> signal(size, 0);
+    for (size_t i = 0; i < reference.size(); ++i) signal[300 + i] = .5f * reference[i];
+    
+    { // 交错存储的完整滤波器谱与分离存储的半谱一致，相关结果相同且峰在时延处
+        const auto full  = xcorr_init<size>(reference);
+        const auto split = xcorr_init_split<size>(reference);
+        CHECK(full.size() == size);
+        CHECK(split.re.size() == size / 2 + 1);
+        for (size_t i = 0; i <= size / 2; ++i) {
+            CHECK_NEAR(full[i].re, split.re[i], 1e-3);
+            CHECK_NEAR(full[i].im, split.im[i], 1e-3);
+        }
+        
+        auto a = signal, b = signal;
+        xcorr<size>(full, a);
+        xcorr<size>(split, b);
+        for (size_t i = 0; i < size; ++i) CHECK_NEAR(a[i], b[i], 1e-4);
+        CHECK(std::max_element(a.begin(), a.end()) - a.begin() == 300);
+    }
+    
+    { // 批量相关：串行与线程池上并行的结果相同，与逐个参考信号相关一致
+        std::vector<std::vector<float>> references;
+        for (size_t r = 0; r < 6; ++r) references.push_back(chirp(100 + 20 * r, 1e-3f * (r + 1)));
+        
+        auto const &plan    = cached_plan<rfft_plan_t>(size);
+        const auto  filters = xcorr_init(references, plan);
+        
+        thread_pool_t pool(3);
+        const auto    serial   = xcorr(filters, signal, plan),
+                      parallel = xcorr(filters, signal, plan, pool);
+        CHECK(serial == parallel);
+        for (size_t r = 0; r < references.size(); ++r) {
+            auto single = signal;
+            xcorr(filters[r], single, plan);
+            for (size_t i = 0; i < size; ++i) CHECK_NEAR(serial[r][i], single[i], 1e-5);
+        }
+    }
+    
+    { // 流式互相关器（不白化）逐块送入，与直接相关一致，每个参考信号一路
+        const auto other = chirp(150, -2e-3f);
+        std::vector<float> x(3000);
+        for (size_t i = 0; i < x.size(); ++i) x[i] = std::sin(.3f * i) + (i % 7) / 7.0f;
+        
+        for (size_t chunk : {1, 100, 5000}) {
+            stream_correlator_t             correlator({reference, other}, 512, false);
+            std::vector<std::vector<float>> outputs;
+            for (size_t i = 0; i < x.size(); i += chunk)
+                correlator.process(x.data() + i, std::min(chunk, x.size() - i), outputs);
+            correlator.flush(outputs);
+            
+            CHECK(outputs.size() == 2);
+            for (size_t r = 0; r < 2; ++r) {
+                auto const &ref = r ? other : reference;
+                CHECK(outputs[r].size() == x.size());
+                for (size_t n = 0; n < std::min(x.size(), outputs[r].size()); ++n) {
+                    double c = 0;
+                    for (size_t k = 0; k < ref.size() && n + k < x.size(); ++k) c += x[n + k] * ref[k];
+                    CHECK_NEAR(outputs[r][n], c, 1e-3);
+                }
+            }
+        }
+    }
+    
+    { // 白化时第一帧与对同一帧做 xcorr 的结果一致
+        stream_correlator_t correlator(reference, size);
+        auto                outputs = correlator.process(signal);
+        auto                expected = signal;
+        xcorr(xcorr_init(reference, size), expected, size);
+        CHECK(outputs[0].size() == correlator.block_size());
+        for (size_t i = 0; i < outputs[0].size(); ++i) CHECK_NEAR(outputs[0][i], expected[i], 1e-4);
+    }
+    
+    return failures();
+}